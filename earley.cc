@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "earley.h"
+
+EarleyRecognizer::EarleyRecognizer(const Grammar& grammar) : itemCount(0), tableCount(0)
+{
+    g = BuildDenseGrammar(grammar);
+    acceptRule = -1;
+    if(g.start < 0){ //nothing to recognize
+        return;
+    }
+
+    // augment the grammar with S' -> S so that acceptance is a single item
+    // that no Leo chain can skip
+    int augmented = g.names.size();
+    g.names.push_back("S'");
+    g.isTerminal.push_back(false);
+    g.nullable.push_back(g.nullable[g.start]);
+    g.rulesFor.push_back(std::vector<int>());
+    acceptRule = g.left.size();
+    g.left.push_back(augmented);
+    g.right.push_back(std::vector<int>(1, g.start));
+    g.rulesFor[augmented].push_back(acceptRule);
+
+    for(int i = 0; i < g.left.size(); i++){
+        dottedStart.push_back(dottedNext.size());
+        for(int j = 0; j <= g.right[i].size(); j++){
+            dottedNext.push_back(j < g.right[i].size() ? g.right[i][j] : -1);
+            dottedRule.push_back(i);
+        }
+    }
+}
+
+// returns false if the item is already in the set
+bool EarleyRecognizer::insertKey(long long key, int set)
+{
+    if((tableCount + 1) * 2 > (int) table.size()){ //grow and re-insert the current set
+        int size = table.empty() ? 64 : table.size() * 2;
+        table.assign(size, 0);
+        tableStamp.assign(size, -1);
+        tableCount = 0;
+        for(int i = setStart[set]; i < items.size(); i++){
+            insertKey(((long long) items[i].dotted << 32) | items[i].origin, set);
+        }
+    }
+    unsigned long long hash = (unsigned long long) key * 0x9E3779B97F4A7C15ULL;
+    int mask = table.size() - 1;
+    int slot = (hash >> 32) & mask;
+    while(tableStamp[slot] == set){
+        if(table[slot] == key){
+            return false;
+        }
+        slot = (slot + 1) & mask;
+    }
+    table[slot] = key;
+    tableStamp[slot] = set;
+    tableCount++;
+    return true;
+}
+
+void EarleyRecognizer::startSet()
+{
+    setStart.push_back(items.size());
+    tableCount = 0; //stamps of older sets no longer match
+}
+
+void EarleyRecognizer::add(int dotted, int origin, int set)
+{
+    if(insertKey(((long long) dotted << 32) | origin, set)){
+        earleyItem item;
+        item.dotted = dotted;
+        item.origin = origin;
+        items.push_back(item);
+    }
+}
+
+// indexes the items of a finished set by the non-terminal after their dot
+void EarleyRecognizer::finishSet(int set)
+{
+    int first = waiting.size();
+    waitingStart.push_back(first);
+    for(int i = setStart[set]; i < items.size(); i++){
+        int next = dottedNext[items[i].dotted];
+        if(next >= 0 && !g.isTerminal[next]){
+            waiting.push_back(i);
+        }
+    }
+    std::vector<earleyItem>& arena = items;
+    std::vector<int>& next = dottedNext;
+    std::stable_sort(waiting.begin() + first, waiting.end(), [&arena, &next](int a, int b){
+        return next[arena[a].dotted] < next[arena[b].dotted];
+    });
+}
+
+// finds the items of a finished set that wait for symbol
+void EarleyRecognizer::waitingRange(int set, int symbol, int& first, int& last)
+{
+    int end = set + 1 < waitingStart.size() ? waitingStart[set + 1] : waiting.size();
+    std::vector<earleyItem>& arena = items;
+    std::vector<int>& next = dottedNext;
+    std::vector<int>::iterator low = std::lower_bound(waiting.begin() + waitingStart[set], waiting.begin() + end, symbol,
+        [&arena, &next](int item, int value){ return next[arena[item].dotted] < value; });
+    std::vector<int>::iterator high = std::upper_bound(low, waiting.begin() + end, symbol,
+        [&arena, &next](int value, int item){ return value < next[arena[item].dotted]; });
+    first = low - waiting.begin();
+    last = high - waiting.begin();
+}
+
+// Leo's topmost item for completing symbol in a finished set: if exactly one
+// item of the set waits for symbol and symbol is the last on its right hand
+// side, completion is deterministic and can jump to the top of the chain.
+// returns false if completion has to be done normally
+bool EarleyRecognizer::leoItem(int set, int symbol, earleyItem& result)
+{
+    long long key = ((long long) set << 32) | symbol;
+    auto memo = leoItems.find(key);
+    if(memo != leoItems.end()){
+        result = memo->second;
+        return result.dotted >= 0;
+    }
+
+    std::vector<long long> chain; //(set, symbol) pairs on the way up, memoized below
+    std::unordered_set<long long> visited;
+    earleyItem top;
+    top.dotted = -1;
+    top.origin = -1;
+    int currentSet = set;
+    int currentSymbol = symbol;
+    while(true){
+        key = ((long long) currentSet << 32) | currentSymbol;
+        if(!visited.insert(key).second){ //cyclic unit rules: complete normally
+            top.dotted = -1;
+            top.origin = -1;
+            break;
+        }
+        memo = leoItems.find(key);
+        if(memo != leoItems.end()){
+            if(memo->second.dotted >= 0){
+                top = memo->second;
+            }
+            break;
+        }
+        int first, last;
+        waitingRange(currentSet, currentSymbol, first, last);
+        if(last - first != 1){
+            break;
+        }
+        earleyItem item = items[waiting[first]];
+        if(dottedNext[item.dotted + 1] != -1){
+            break;
+        }
+        chain.push_back(key);
+        top.dotted = item.dotted + 1;
+        top.origin = item.origin;
+        currentSet = item.origin;
+        currentSymbol = g.left[dottedRule[item.dotted]];
+    }
+
+    if(chain.empty()){
+        chain.push_back(((long long) set << 32) | symbol);
+    }
+    for(int i = 0; i < chain.size(); i++){
+        leoItems[chain[i]] = top;
+    }
+    result = top;
+    return top.dotted >= 0;
+}
+
+bool EarleyRecognizer::recognize(const std::vector<std::string>& sentence)
+{
+    if(acceptRule < 0){
+        itemCount = 0;
+        return false;
+    }
+    std::vector<int> input;
+    for(int i = 0; i < sentence.size(); i++){
+        auto it = g.ids.find(sentence[i]);
+        if(it == g.ids.end() || !g.isTerminal[it->second]){
+            itemCount = 0;
+            return false; //not a terminal of the grammar
+        }
+        input.push_back(it->second);
+    }
+
+    items.clear();
+    setStart.clear();
+    waiting.clear();
+    waitingStart.clear();
+    leoItems.clear();
+    predicted.assign(g.names.size(), -1);
+    tableStamp.assign(tableStamp.size(), -1);
+
+    startSet();
+    add(dottedStart[acceptRule], 0, 0);
+
+    for(int set = 0; set <= input.size(); set++){
+        std::vector<earleyItem> scanned;
+        for(int i = setStart[set]; i < items.size(); i++){
+            earleyItem item = items[i];
+            int next = dottedNext[item.dotted];
+            if(next == -1){ //completer
+                int completed = g.left[dottedRule[item.dotted]];
+                earleyItem top;
+                if(item.origin < set && leoItem(item.origin, completed, top)){
+                    add(top.dotted, top.origin, set);
+                } else if(item.origin < set){
+                    int first, last;
+                    waitingRange(item.origin, completed, first, last);
+                    for(int w = first; w < last; w++){
+                        add(items[waiting[w]].dotted + 1, items[waiting[w]].origin, set);
+                    }
+                } else {
+                    for(int w = setStart[set]; w < items.size(); w++){
+                        if(dottedNext[items[w].dotted] == completed){
+                            add(items[w].dotted + 1, items[w].origin, set);
+                        }
+                    }
+                }
+            } else if(!g.isTerminal[next]){ //predictor
+                if(predicted[next] != set){
+                    predicted[next] = set;
+                    for(int r = 0; r < g.rulesFor[next].size(); r++){
+                        add(dottedStart[g.rulesFor[next][r]], set, set);
+                    }
+                }
+                if(g.nullable[next]){
+                    add(item.dotted + 1, item.origin, set);
+                }
+            } else if(set < input.size() && input[set] == next){ //scanner
+                item.dotted++;
+                scanned.push_back(item);
+            }
+        }
+        finishSet(set);
+
+        if(set == input.size()){
+            break;
+        }
+        if(scanned.empty()){
+            itemCount = items.size();
+            return false;
+        }
+        startSet();
+        for(int i = 0; i < scanned.size(); i++){
+            add(scanned[i].dotted, scanned[i].origin, set + 1);
+        }
+    }
+
+    itemCount = items.size();
+    for(int i = setStart[input.size()]; i < items.size(); i++){
+        if(items[i].dotted == dottedStart[acceptRule] + 1 && items[i].origin == 0){
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,54 @@
+#ifndef __EARLEY__H__
+#define __EARLEY__H__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "grammar.h"
+
+// Earley recognizer for arbitrary (ambiguous, left-recursive) grammars.
+// Items are a dotted rule and an origin; the dotted rules of all rules are
+// numbered consecutively so that advancing the dot is adding one. Items of
+// each Earley set are allocated contiguously in one arena and deduplicated
+// with a hash table that is reset per set. Prediction of a nullable
+// non-terminal also advances over it (Aycock and Horspool), and Leo's
+// optimization keeps right recursion linear.
+
+struct earleyItem {
+    int dotted;   // dotted rule
+    int origin;   // Earley set in which the item was predicted
+};
+
+class EarleyRecognizer{
+    public:
+        explicit EarleyRecognizer(const Grammar& grammar);
+        bool recognize(const std::vector<std::string>& sentence);
+        long long itemCount; // number of items created by the last recognize()
+    private:
+        denseGrammar g;
+        int acceptRule;                  // augmented rule S' -> S
+        std::vector<int> dottedStart;    // first dotted rule of each rule
+        std::vector<int> dottedNext;     // symbol after the dot, -1 at the end
+        std::vector<int> dottedRule;
+
+        std::vector<earleyItem> items;   // arena: set i is items[setStart[i], setStart[i+1])
+        std::vector<int> setStart;
+        std::vector<int> waiting;        // per finished set, items with a non-terminal
+        std::vector<int> waitingStart;   // after the dot sorted by that non-terminal
+        std::vector<int> predicted;      // last set in which a non-terminal was predicted
+        std::unordered_map<long long, earleyItem> leoItems;
+
+        std::vector<long long> table;    // open addressing item set of the current set
+        std::vector<int> tableStamp;
+        int tableCount;
+
+        void startSet();
+        void add(int dotted, int origin, int set);
+        bool insertKey(long long key, int set);
+        void finishSet(int set);
+        void waitingRange(int set, int symbol, int& first, int& last);
+        bool leoItem(int set, int symbol, earleyItem& result);
+};
+
+#endif  //__EARLEY__H__
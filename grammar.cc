@@ -0,0 +1,597 @@
+#include <istream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <utility>
+#include <unordered_set>
+#include <unordered_map>
+
+#include "grammar.h"
+#include "inputbuf.h"
+
+Grammar::Grammar(std::istream& source) : syntaxError(false), errorLine(0), symbolQueue(NULL)
+{
+    lexer = new LexicalAnalyzer(source);
+    parse_input();
+}
+
+Grammar::Grammar(const std::string& text) : syntaxError(false), errorLine(0), symbolQueue(NULL)
+{
+    MemoryBuffer buffer(text.data(), text.data() + text.size());
+    std::istream source(&buffer);
+    lexer = new LexicalAnalyzer(source);
+    parse_input();
+}
+
+Grammar::Grammar(LexicalAnalyzer* lexer)
+    : syntaxError(false), errorLine(0), lexer(lexer), symbolQueue(NULL)
+{
+    parse_input();
+}
+
+// reads the grammar with lexing, parsing and symbol classification running
+// as concurrent stages connected by queues of queueCapacity blocks. The
+// parser runs on the calling thread
+Grammar::Grammar(std::istream& source, int queueCapacity) : syntaxError(false), errorLine(0)
+{
+    SpscQueue<TokenBlock> tokens(queueCapacity);
+    SpscQueue<symbolBlock> symbols(queueCapacity);
+
+    std::thread lexing([&source, &tokens]() {
+        LexicalAnalyzer producer(source, tokens);
+    });
+    std::thread classifying([this, &symbols]() {
+        symbolBlock block = symbols.pop();
+        while(!block.empty()){
+            for(size_t i = 0; i < block.size(); i++){
+                classify_Symbol(block[i].name, block[i].left);
+            }
+            block = symbols.pop();
+        }
+    });
+
+    lexer = new LexicalAnalyzer(tokens);
+    symbolQueue = &symbols;
+    parse_input();
+    while(lexer->GetToken().token_type != END_OF_FILE){
+        //after a syntax error, let the lexing stage finish
+    }
+    if(!pendingSymbols.empty()){
+        symbols.push(std::move(pendingSymbols));
+    }
+    symbols.push(symbolBlock()); //end of the symbol stream
+
+    classifying.join();
+    lexing.join();
+    symbolQueue = NULL;
+    delete lexer; //it reads from tokens, which goes away with this frame
+    lexer = NULL;
+}
+
+Grammar::~Grammar()
+{
+    delete lexer;
+}
+
+void Grammar::parse_input()
+{
+    parse_Grammar();
+    if(syntaxError){
+        return;
+    }
+    expect(END_OF_FILE);
+}
+
+// records the first syntax error; the parse functions stop once it is set
+void Grammar::syntax_error(const Token& token) {
+    if(!syntaxError){
+        syntaxError = true;
+        errorLine = token.line_no;
+    }
+}
+
+void Grammar::parse_Grammar(){
+    parse_Rule_list();
+    if(syntaxError){
+        return;
+    }
+    expect(HASH);
+}
+
+void Grammar::parse_Rule_list(){
+    parse_Rule();
+    while(!syntaxError && lexer->peek(1).token_type != HASH){ //loop until HASH is detected.
+        parse_Rule();
+    }
+}
+
+void Grammar::parse_Id_list(){
+    parse_Id();
+    while(!syntaxError && lexer->peek(1).token_type != STAR){ //stop if there are no more IDs.
+        parse_Id();
+    }
+}
+
+void Grammar::parse_Id(){
+    Token t = expect(ID);
+    if(syntaxError){
+        return;
+    }
+    
+    rule_list[rule_list.size() - 1].right.push_back(t.lexeme); //push to right hand side of the last rule
+
+    add_Symbol(t.lexeme, false);
+}
+
+// symbols per block handed to the classification stage
+static const size_t symbolBlockSize = 1024;
+
+// classifies a symbol right away, or hands it to the classification stage
+// in blocks of symbolBlockSize when the grammar is read by a pipeline
+void Grammar::add_Symbol(const std::string& name, bool left){
+    if(symbolQueue != NULL){
+        symbolEvent event;
+        event.name = name;
+        event.left = left;
+        pendingSymbols.push_back(event);
+        if(pendingSymbols.size() == symbolBlockSize){
+            symbolQueue->push(std::move(pendingSymbols));
+            pendingSymbols = symbolBlock();
+            pendingSymbols.reserve(symbolBlockSize);
+        }
+    } else {
+        classify_Symbol(name, left);
+    }
+}
+
+void Grammar::classify_Symbol(const std::string& name, bool left){
+    if(left && terminals.count(name)){ //if we wrongly classify a symbol as a terminal when it is not, remove it from terminals and add to non-terminals
+        terminals.erase(name);
+        nonTerminals.insert(name);
+    }
+    // add it to the allSymbols list if we've never seen it before
+    if (!nonTerminals.count(name) && !terminals.count(name)) {
+        allSymbols.push_back(name);
+        if(left){
+            nonTerminals.insert(name);
+        } else {
+            terminals.insert(name);
+        }
+    }
+}
+
+void Grammar::parse_Rule(){
+
+    // As we parse this rule, we should add it to rule_list.
+
+    Token t = expect(ID);
+    if(syntaxError){
+        return;
+    }
+    
+    rule newRule;
+    newRule.left = t.lexeme;
+    add_Symbol(t.lexeme, true);
+
+    //adds new rule to rule list.
+    rule_list.push_back(newRule); 
+
+    expect(ARROW);
+    if(syntaxError){
+        return;
+    }
+
+    parse_Right_hand_side();
+    if(syntaxError){
+        return;
+    }
+
+    expect(STAR);
+
+}
+
+void Grammar::parse_Right_hand_side(){
+    Token t = lexer->peek(1);
+    if(t.token_type == STAR){
+        return;
+    } else {
+        parse_Id_list(); //parse ID List if it's not a STAR
+    }
+}
+
+Token Grammar::expect(TokenType token){
+    Token tok = lexer->GetToken();
+    if(tok.token_type != token){
+        syntax_error(tok);
+    }
+    return tok;
+}
+
+symbolLists SymbolListsAlgo(const Grammar& g)
+{
+    symbolLists lists;
+    if(g.syntaxError){
+        return lists;
+    }
+    for(int i = 0; i < g.allSymbols.size(); i++){
+        if(g.terminals.count(g.allSymbols[i])){
+            lists.terminals.push_back(g.allSymbols[i]);
+        } else {
+            lists.nonTerminals.push_back(g.allSymbols[i]);
+        }
+    }
+    return lists;
+}
+
+// returns the rules that remain after removing useless symbols, in
+// their original order
+std::vector<rule> UsefulRulesAlgo(const Grammar& g)
+{
+    if(g.syntaxError){
+        return std::vector<rule>();
+    }
+    std::unordered_map<std::string, bool> generatingSymbols; //create a map to check for generating symbols
+    std::unordered_set<std::string> terminals = g.terminals;
+    std::unordered_set<std::string> nonTerminals = g.nonTerminals;
+    std::vector<rule> rule_list = g.rule_list;
+
+    // "#" to represent epsilon
+    generatingSymbols["#"] = true;
+
+    for (auto it = terminals.begin(); it != terminals.end(); ++it) { //all terminals are generating
+        generatingSymbols[*it] = true;
+    }
+
+    for(auto jt = nonTerminals.begin(); jt != nonTerminals.end(); ++jt){ //set all non terminals to false for now.
+        generatingSymbols[*jt] = false;
+    }
+
+    bool change = true;
+    while (change) {
+        change = false;
+        for (int i = 0; i < rule_list.size(); i++){
+            rule currentRule = rule_list[i];
+            bool ruleIsGenerating = true;
+            for (int j = 0; j < currentRule.right.size(); j++){
+                if(!generatingSymbols[currentRule.right[j]]){
+                    ruleIsGenerating = false;
+                    break;
+                }
+            } 
+            if(ruleIsGenerating && !generatingSymbols[currentRule.left]){ //sets it only once
+                generatingSymbols[currentRule.left] = true;
+                change = true;
+            }
+        }
+    }
+
+    std::vector<rule> RulesGen; //new vector
+    for(int i = 0; i < rule_list.size(); i++){
+        if(!generatingSymbols[rule_list[i].left]) {
+            continue;
+        }
+        
+        bool rightGen = true;
+
+        for(int j = 0; j < rule_list[i].right.size(); j++){
+            if(!generatingSymbols[rule_list[i].right[j]]){
+                rightGen = false;
+                break;
+            }
+        }
+
+        if(rightGen){
+            RulesGen.push_back(rule_list[i]);
+        }
+    }
+
+    std::unordered_map<std::string, bool> reachableSymbols;
+
+    //set all terminals to not reachable for now
+    for (auto it = terminals.begin(); it != terminals.end(); ++it) {
+        reachableSymbols[*it] = false;
+    }
+    
+    //set all non terminals to false for now
+    for(auto jt = nonTerminals.begin(); jt != nonTerminals.end(); ++jt){
+        reachableSymbols[*jt] = false;
+    }
+
+    // if its the start symbol, set it to true.
+    reachableSymbols[rule_list[0].left] = true; 
+
+    change = true;
+    while(change){
+        change = false;
+        for(int i = 0; i < RulesGen.size(); i++){
+            rule currentRule = RulesGen[i];
+            if(reachableSymbols[currentRule.left]) {
+                for(int j = 0; j < RulesGen[i].right.size(); j++){
+                    if(!reachableSymbols[currentRule.right[j]]) //set to true if we haven't already
+                    {
+                        reachableSymbols[currentRule.right[j]] = true;
+                        change = true;
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<rule> usefulRules;
+
+    for(int i = 0; i < RulesGen.size(); i++){
+        if(!reachableSymbols[RulesGen[i].left]){
+            continue;
+        }
+
+        bool rightReach = true;
+
+        for(int j = 0; j < RulesGen[i].right.size(); j++){
+            if(!reachableSymbols[RulesGen[i].right[j]]){
+                rightReach = false;
+                break;
+            }
+        }
+
+        if(rightReach){
+            usefulRules.push_back(RulesGen[i]);
+        }
+    }
+    return usefulRules;
+}
+
+symbolSets FirstSetAlgo(const Grammar& g){
+    if(g.syntaxError){
+        return symbolSets();
+    }
+    std::unordered_map<std::string, std::unordered_set<std::string>> firstSets; //map of first sets
+    std::unordered_set<std::string> terminals = g.terminals;
+    std::unordered_set<std::string> nonTerminals = g.nonTerminals;
+    std::vector<rule> ruleList = g.rule_list;
+
+    for(auto jt = nonTerminals.begin(); jt != nonTerminals.end(); ++jt){
+        firstSets[*jt] = {}; //set first sets of nonterminals as empty.
+    }
+
+    for(auto it = terminals.begin(); it != terminals.end(); ++it){
+        firstSets[*it] = {*it};
+    }
+    
+    bool changed = true;
+    while(changed){ //loop until something is changed
+        changed = false;
+        for(int i = 0; i < ruleList.size(); i++){ 
+
+            // A -> B
+
+            int initialSize = firstSets[ruleList[i].left].size();
+
+            if(ruleList[i].right.empty()){ //check if RHS is empty
+                firstSets[ruleList[i].left].insert("#"); //add epsilon in first of RHS
+            }
+            else{
+                for (int j = 0; j < ruleList[i].right.size(); j++) { //loop through all symbols in RHS
+                    if(terminals.count(ruleList[i].right[j])){
+                        firstSets[ruleList[i].left].insert(ruleList[i].right[j]); //add first of that terminal to first set of LHS
+                        break;
+                    } else {
+                        bool hasEpsilon = false;
+                        for(auto iter = firstSets[ruleList[i].right[j]].begin(); iter != firstSets[ruleList[i].right[j]].end(); ++iter){ //rule 3
+                            // insert as long as it's not epsilon
+                            if (*iter != "#") {
+                                firstSets[ruleList[i].left].insert(*iter);
+                            } else {
+                                hasEpsilon = true;
+                            }
+                        }
+
+                        if (!hasEpsilon) { //rule 4
+                            break;
+                        } else {
+                            if(j == ruleList[i].right.size() - 1){
+                                firstSets[ruleList[i].left].insert("#"); //rule 5
+                            }
+                            continue;
+                        }
+                    }
+                }
+            }
+            int finalSize = firstSets[ruleList[i].left].size();
+            if (finalSize != initialSize){
+                changed = true;
+            }
+        }
+    }
+    return firstSets;
+}
+
+symbolSets FollowSetAlgo(const Grammar& g, symbolSets firstSets){
+    if(g.syntaxError){
+        return symbolSets();
+    }
+    std::unordered_map<std::string, std::unordered_set<std::string>> followSets;
+    std::unordered_set<std::string> terminals = g.terminals;
+    std::unordered_set<std::string> nonTerminals = g.nonTerminals;
+    std::vector<std::string> allSymbols = g.allSymbols;
+    std::vector<rule> ruleList = g.rule_list;
+
+    
+
+    for(auto it = nonTerminals.begin(); it != nonTerminals.end(); ++it){
+        followSets[*it] = {}; //sets all nonterminals as empty for now
+    }
+    
+    followSets[ruleList[0].left] = { "$" }; //set FOLLOW of first rule as $
+
+    bool changed = true;
+    while(changed){
+        changed = false;
+        for(int i = 0; i < ruleList.size(); i++){ //loop through all rules
+            for(int j = ruleList[i].right.size() - 1; j >= 0; j--){
+                if(nonTerminals.count(ruleList[i].right[j])){
+                    int initialSize = followSets[ruleList[i].right[j]].size();
+                    
+                    for (auto it = followSets[ruleList[i].left].begin(); it != followSets[ruleList[i].left].end(); ++it){
+                        followSets[ruleList[i].right[j]].insert(*it); //create array of follow sets of LHS. Loop through array and add symbols in Follow set of current RHS
+                    }
+
+                    int finalSize = followSets[ruleList[i].right[j]].size();
+
+                    if(initialSize != finalSize){
+                        changed = true;
+                    }
+                    
+                }
+
+                if(firstSets[ruleList[i].right[j]].count("#")){
+                    continue;
+                } else {
+                    break;
+                }
+            }
+            for(int k = 0; k < ruleList[i].right.size(); k++){
+                if(!nonTerminals.count(ruleList[i].right[k])){
+                    continue;
+                } else {
+                    for(int l = k + 1; l < ruleList[i].right.size(); l++){
+                        
+                        int initialSize = followSets[ruleList[i].right[k]].size();
+                        bool epsilonPresent = false;
+                        // add everything in the first set of the symbol at l 
+                        // into the follow set of the symbol at k
+                        std::unordered_set<std::string> firstSetofL = firstSets[ruleList[i].right[l]];
+                        for(auto it = firstSetofL.begin(); it != firstSetofL.end(); ++it){
+                            if(*it != "#"){
+                                followSets[ruleList[i].right[k]].insert(*it);
+                            } else {
+                                epsilonPresent = true;
+                            }
+                        }
+                        
+                        int finalSize = followSets[ruleList[i].right[k]].size();
+
+                        if(initialSize != finalSize){
+                            changed = true;
+                        }
+
+                        if(!epsilonPresent){
+                            break;
+                        }
+                    }
+                }
+            }
+            
+        }
+    }
+    return followSets;
+}
+
+// formats a FIRST or FOLLOW set the way tasks 3 and 4 print it: the special
+// symbol ("#" or "$") first, then the other members in allSymbols order
+std::string SetToString(const Grammar& g, const std::unordered_set<std::string>& set, const std::string& special)
+{
+    std::string stringToPrint = "{ ";
+    if(!set.empty()){
+
+        if(set.count(special)){
+            stringToPrint += special + ", ";
+        }
+
+        for(int j = 0; j < g.allSymbols.size(); j++){
+            if(set.count(g.allSymbols[j])){
+                stringToPrint += g.allSymbols[j] + ", ";
+            }
+        }
+
+        stringToPrint = stringToPrint.substr(0, stringToPrint.length()-2);
+    }
+
+    stringToPrint += " }";
+    return stringToPrint;
+}
+
+// formats a rule the way task 2 prints it
+std::string RuleToString(const std::string& left, const std::vector<std::string>& right)
+{
+    std::string text = left + " -> ";
+    if(right.empty()){
+        return text + "#";
+    }
+    for(int j = 0; j < right.size(); j++){
+        text += right[j];
+        if(j != right.size() - 1){
+            text += " ";
+        }
+    }
+    return text;
+}
+
+// writes rules in the input format of the grammar
+std::string GrammarToString(const std::vector<rule>& rules)
+{
+    std::string text;
+    for(int i = 0; i < rules.size(); i++){
+        text += rules[i].left + " ->";
+        for(int j = 0; j < rules[i].right.size(); j++){
+            text += " " + rules[i].right[j];
+        }
+        text += " *\n";
+    }
+    return text + "#\n";
+}
+
+denseGrammar BuildDenseGrammar(const Grammar& g)
+{
+    denseGrammar dense;
+    dense.start = -1;
+    if(g.syntaxError){
+        return dense;
+    }
+    dense.names = g.allSymbols;
+    for(int i = 0; i < dense.names.size(); i++){
+        dense.ids[dense.names[i]] = i;
+        dense.isTerminal.push_back(g.terminals.count(dense.names[i]) > 0);
+    }
+    dense.rulesFor.resize(dense.names.size());
+    for(int i = 0; i < g.rule_list.size(); i++){
+        std::vector<int> right;
+        for(int j = 0; j < g.rule_list[i].right.size(); j++){
+            right.push_back(dense.ids[g.rule_list[i].right[j]]);
+        }
+        dense.left.push_back(dense.ids[g.rule_list[i].left]);
+        dense.right.push_back(right);
+        dense.rulesFor[dense.left.back()].push_back(i);
+    }
+    dense.start = dense.ids[g.rule_list[0].left];
+
+    // nullable symbols, without FIRST sets: a rule makes its left hand side
+    // nullable once every symbol on its right is, so each rule counts the
+    // symbols not yet known to be nullable
+    std::vector<std::vector<int>> occurrences(dense.names.size()); //rules with the symbol on the right
+    std::vector<int> unknown(dense.left.size());
+    std::vector<int> work;
+    dense.nullable.assign(dense.names.size(), false);
+    for(int r = 0; r < dense.left.size(); r++){
+        unknown[r] = dense.right[r].size();
+        for(int j = 0; j < dense.right[r].size(); j++){
+            occurrences[dense.right[r][j]].push_back(r);
+        }
+        if(unknown[r] == 0 && !dense.nullable[dense.left[r]]){
+            dense.nullable[dense.left[r]] = true;
+            work.push_back(dense.left[r]);
+        }
+    }
+    while(!work.empty()){
+        int symbol = work.back();
+        work.pop_back();
+        for(int i = 0; i < occurrences[symbol].size(); i++){
+            int r = occurrences[symbol][i];
+            if(--unknown[r] == 0 && !dense.nullable[dense.left[r]]){
+                dense.nullable[dense.left[r]] = true;
+                work.push_back(dense.left[r]);
+            }
+        }
+    }
+    return dense;
+}
+
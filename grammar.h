@@ -0,0 +1,98 @@
+#ifndef __GRAMMAR__H__
+#define __GRAMMAR__H__
+
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "lexer.h"
+
+// Grammar library for the FIRST & FOLLOW project. Nothing here uses global
+// state, standard input or standard output: a Grammar is read from a stream
+// or an in-memory buffer, analyses return their results, and different
+// grammars can be read and analyzed on different threads at the same time.
+
+struct rule {
+    std::string left;
+    std::vector<std::string> right;
+};
+
+// a symbol on its way from the parser to the classification stage. Symbols
+// travel in blocks; an empty block ends the stream
+struct symbolEvent {
+    std::string name;
+    bool left;  // seen as the left hand side of a rule
+};
+typedef std::vector<symbolEvent> symbolBlock;
+
+// A syntax error does not end the program: parsing stops, syntaxError is
+// set and errorLine is the line of the token at which parsing stopped.
+// The analyses below return empty results for such a grammar.
+class Grammar{
+    public:
+        explicit Grammar(std::istream& source);
+        explicit Grammar(const std::string& text);
+        explicit Grammar(LexicalAnalyzer* lexer);
+        Grammar(std::istream& source, int queueCapacity);
+        ~Grammar();
+        std::vector<rule> rule_list;
+        std::unordered_set<std::string> nonTerminals;
+        std::unordered_set<std::string> terminals;
+        std::vector<std::string> allSymbols;
+        bool syntaxError;
+        int errorLine;
+    private:
+        Grammar(const Grammar&);
+        Grammar& operator=(const Grammar&);
+
+        LexicalAnalyzer* lexer;
+        SpscQueue<symbolBlock>* symbolQueue; // classification stage, NULL when not pipelined
+        symbolBlock pendingSymbols;          // not yet handed to the classification stage
+        void parse_input();
+        void parse_Grammar();
+        void parse_Rule_list();
+        void parse_Id_list();
+        void parse_Id();
+        void add_Symbol(const std::string& name, bool left);
+        void classify_Symbol(const std::string& name, bool left);
+        void parse_Rule();
+        void parse_Right_hand_side();
+        void syntax_error(const Token& token);
+        Token expect(TokenType token);
+};
+
+typedef std::unordered_map<std::string, std::unordered_set<std::string>> symbolSets;
+
+// terminals and non-terminals, each in the order they first appear
+struct symbolLists {
+    std::vector<std::string> terminals;
+    std::vector<std::string> nonTerminals;
+};
+
+symbolLists SymbolListsAlgo(const Grammar& g);
+std::vector<rule> UsefulRulesAlgo(const Grammar& g);
+symbolSets FirstSetAlgo(const Grammar& g);
+symbolSets FollowSetAlgo(const Grammar& g, symbolSets firstSets);
+
+std::string SetToString(const Grammar& g, const std::unordered_set<std::string>& set, const std::string& special);
+std::string RuleToString(const std::string& left, const std::vector<std::string>& right);
+std::string GrammarToString(const std::vector<rule>& rules);
+
+// the grammar with every symbol numbered in allSymbols order, so that
+// analyses can index arrays instead of hashing strings
+struct denseGrammar {
+    std::vector<std::string> names;
+    std::unordered_map<std::string, int> ids;
+    std::vector<bool> isTerminal;
+    std::vector<bool> nullable;
+    std::vector<int> left;                  // left hand side of each rule
+    std::vector<std::vector<int>> right;    // right hand side of each rule
+    std::vector<std::vector<int>> rulesFor; // rule numbers for each non-terminal
+    int start;                              // -1 if the grammar has a syntax error
+};
+
+denseGrammar BuildDenseGrammar(const Grammar& g);
+
+#endif  //__GRAMMAR__H__
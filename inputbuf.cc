@@ -3,22 +3,33 @@
  *
  * Do not share this file with anyone
  */
-#include <iostream>
 #include <istream>
 #include <vector>
 #include <string>
 #include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "inputbuf.h"
 
 using namespace std;
 
+// a buffer without a stream, for lexers that get their tokens elsewhere
+InputBuffer::InputBuffer() : in(NULL)
+{
+}
+
+InputBuffer::InputBuffer(istream& source) : in(&source)
+{
+}
+
 bool InputBuffer::EndOfInput()
 {
     if (!input_buffer.empty())
         return false;
     else
-        return cin.eof();
+        return in == NULL || in->eof();
 }
 
 char InputBuffer::UngetChar(char c)
@@ -33,8 +44,8 @@ void InputBuffer::GetChar(char& c)
     if (!input_buffer.empty()) {
         c = input_buffer.back();
         input_buffer.pop_back();
-    } else {
-        cin.get(c);
+    } else if (in != NULL) {
+        in->get(c);
     }
 }
 
@@ -44,3 +55,47 @@ string InputBuffer::UngetString(string s)
         input_buffer.push_back(s[s.size()-i-1]);
     return s;
 }
+
+MemoryBuffer::MemoryBuffer(const char* begin, const char* end)
+{
+    char* first = const_cast<char*>(begin);
+    setg(first, first, const_cast<char*>(end));
+}
+
+MappedInput::MappedInput(int fd) : data(NULL), size(0), mapped(false)
+{
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* address = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            data = (char*) address;
+            size = info.st_size;
+            mapped = true;
+            return;
+        }
+    }
+
+    // pipes, terminals and files that cannot be mapped are read instead
+    char chunk[65536];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0)
+        contents.insert(contents.end(), chunk, chunk + n);
+    data = contents.data();
+    size = contents.size();
+}
+
+MappedInput::~MappedInput()
+{
+    if (mapped)
+        munmap(data, size);
+}
+
+const char* MappedInput::begin() const
+{
+    return data;
+}
+
+const char* MappedInput::end() const
+{
+    return data + size;
+}
@@ -6,18 +6,51 @@
 #ifndef __INPUT_BUFFER__H__
 #define __INPUT_BUFFER__H__
 
+#include <cstddef>
+#include <istream>
+#include <streambuf>
 #include <string>
 #include <vector>
 
 class InputBuffer {
   public:
+    InputBuffer();
+    explicit InputBuffer(std::istream&);
+
     void GetChar(char&);
     char UngetChar(char);
     std::string UngetString(std::string);
     bool EndOfInput();
 
   private:
+    std::istream* in;
     std::vector<char> input_buffer;
 };
 
+// stream buffer reading from a range of characters in memory
+class MemoryBuffer : public std::streambuf {
+  public:
+    MemoryBuffer(const char* begin, const char* end);
+};
+
+// the whole content of a file descriptor: memory-mapped when it is a
+// regular file, read into memory otherwise
+class MappedInput {
+  public:
+    explicit MappedInput(int fd);
+    ~MappedInput();
+
+    const char* begin() const;
+    const char* end() const;
+
+  private:
+    MappedInput(const MappedInput&);
+    MappedInput& operator=(const MappedInput&);
+
+    char* data;
+    size_t size;
+    bool mapped;
+    std::vector<char> contents;
+};
+
 #endif  //__INPUT_BUFFER__H__
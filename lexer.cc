@@ -3,11 +3,15 @@
  *
  * Do not share this file with anyone
  */
-#include <iostream>
 #include <istream>
 #include <vector>
 #include <string>
 #include <cctype>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <iterator>
+#include <utility>
 
 #include "lexer.h"
 #include "inputbuf.h"
@@ -16,16 +20,98 @@ using namespace std;
 
 // Lexer modified for FIRST & FOLLOW project
 
-string reserved[] = { "END_OF_FILE", "ARROW", "STAR", "HASH", "ID", "ERROR" };
+// lexes the whole stream into tokenList
+LexicalAnalyzer::LexicalAnalyzer(istream& in)
+    : input(in), output(NULL), source(NULL), sourceDone(true)
+{
+    ReadAllTokens();
+}
+
+// tokens per block handed from the producer to the consumer stage
+static const size_t tokenBlockSize = 1024;
+
+// producer stage of a pipeline: lexes the whole stream, pushing the tokens
+// to output in blocks of tokenBlockSize. The last block ends with END_OF_FILE
+LexicalAnalyzer::LexicalAnalyzer(istream& in, SpscQueue<TokenBlock>& out)
+    : input(in), output(&out), source(NULL), sourceDone(true)
+{
+    ReadAllTokens();
+}
+
+// consumer stage of a pipeline: GetToken() and peek() take tokens from
+// source as they are needed, waiting for the producer if necessary
+LexicalAnalyzer::LexicalAnalyzer(SpscQueue<TokenBlock>& in)
+    : output(NULL), source(&in), sourceDone(false)
+{
+    this->line_no = 1;
+    index = 0;
+    tmp.lexeme = "";
+    tmp.line_no = 1;
+    tmp.token_type = ERROR;
+}
 
-void Token::Print()
+// Lexes the characters in [begin, end) on up to "threads" threads. The input
+// is split into chunks that end right after a '*'; a STAR token never looks
+// ahead, so every chunk starts in the same state as the sequential lexer
+// would. Chunk token lists are concatenated with line numbers offset by the
+// newlines in the preceding chunks, giving the same tokens (including ERROR
+// tokens) as lexing the whole input sequentially.
+LexicalAnalyzer::LexicalAnalyzer(const char* begin, const char* end, int threads)
+    : output(NULL), source(NULL), sourceDone(true)
 {
-    cout << "{" << this->lexeme << " , "
-         << reserved[(int) this->token_type] << " , "
-         << this->line_no << "}\n";
+    vector<const char*> bounds;
+    bounds.push_back(begin);
+    size_t length = end - begin;
+    for (int i = 1; i < threads && length > 0; i++) {
+        const char* target = begin + length / threads * i;
+        if (target < bounds.back())
+            continue;
+        const char* star = (const char*) memchr(target, '*', end - target);
+        if (star == NULL)
+            break;
+        if (star + 1 > bounds.back() && star + 1 < end)
+            bounds.push_back(star + 1);
+    }
+    bounds.push_back(end);
+
+    int chunks = bounds.size() - 1;
+    vector<LexicalAnalyzer*> lexers(chunks);
+    vector<thread> workers;
+    for (int i = 0; i < chunks; i++) {
+        workers.push_back(thread([&lexers, &bounds, i]() {
+            MemoryBuffer buffer(bounds[i], bounds[i + 1]);
+            istream source(&buffer);
+            lexers[i] = new LexicalAnalyzer(source);
+        }));
+    }
+    for (int i = 0; i < chunks; i++)
+        workers[i].join();
+
+    size_t total = 0;
+    for (int i = 0; i < chunks; i++)
+        total += lexers[i]->tokenList.size();
+    tokenList.reserve(total);
+
+    int offset = 0;
+    for (int i = 0; i < chunks; i++) {
+        for (unsigned j = 0; j < lexers[i]->tokenList.size(); j++) {
+            Token token = lexers[i]->tokenList[j];
+            token.line_no += offset;
+            tokenList.push_back(token);
+        }
+        if (i == chunks - 1)
+            line_no = lexers[i]->line_no + offset;
+        else
+            offset += count(bounds[i], bounds[i + 1], '\n');
+        delete lexers[i];
+    }
+    index = 0;
+    tmp.lexeme = "";
+    tmp.line_no = line_no;
+    tmp.token_type = ERROR;
 }
 
-LexicalAnalyzer::LexicalAnalyzer()
+void LexicalAnalyzer::ReadAllTokens()
 {
     this->line_no = 1;
     tmp.lexeme = "";
@@ -34,13 +120,49 @@ LexicalAnalyzer::LexicalAnalyzer()
 
     Token token = GetTokenMain();
     index = 0;
+    if (output != NULL)
+        tokenList.reserve(tokenBlockSize);
 
     while (token.token_type != END_OF_FILE)
     {
-        tokenList.push_back(token);     // push token into internal list
+        tokenList.push_back(std::move(token)); // push token into internal list
+        if (output != NULL && tokenList.size() == tokenBlockSize) {
+            output->push(std::move(tokenList)); // hand the block to the next stage
+            tokenList = TokenBlock();
+            tokenList.reserve(tokenBlockSize);
+        }
         token = GetTokenMain();        // and get next token from standatd input
     }
     // pushes END_OF_FILE is not pushed on the token list
+    if (output != NULL) {
+        tokenList.push_back(token);     // but it tells the next stage to stop
+        output->push(std::move(tokenList));
+        tokenList.clear();
+    }
+}
+
+// makes sure tokenList holds count tokens past index, unless the producer
+// has already sent END_OF_FILE. Tokens are only needed until they are
+// consumed, so once all of them are the list starts over
+void LexicalAnalyzer::Fill(int count)
+{
+    if (!sourceDone && index == (int) tokenList.size()) {
+        tokenList.clear();
+        index = 0;
+    }
+    while (!sourceDone && (int) tokenList.size() < index + count) {
+        TokenBlock block = source->pop();
+        if (block.back().token_type == END_OF_FILE) {
+            sourceDone = true;
+            line_no = block.back().line_no;
+            block.pop_back();
+        }
+        if (tokenList.empty())
+            tokenList.swap(block);
+        else
+            tokenList.insert(tokenList.end(), make_move_iterator(block.begin()),
+                             make_move_iterator(block.end()));
+    }
 }
 
 bool LexicalAnalyzer::SkipSpace()
@@ -94,6 +216,7 @@ Token LexicalAnalyzer::ScanId()
 Token LexicalAnalyzer::GetToken()
 {
     Token token;
+    Fill(1);
     if (index == tokenList.size()){       // return end of file if
         token.lexeme = "";                // index is too large
         token.line_no = line_no;
@@ -106,14 +229,19 @@ Token LexicalAnalyzer::GetToken()
     return token;
 }
 
-// peek requires that the argument "howFar" be positive.
+// peek requires that the argument "howFar" be positive; otherwise it
+// returns an ERROR token.
 Token LexicalAnalyzer::peek(int howFar)
 {
     if (howFar <= 0) {      // peeking backward or in place is not allowed
-        cout << "LexicalAnalyzer:peek:Error: non positive argument\n";
-        exit(-1);
+        Token token;
+        token.lexeme = "";
+        token.line_no = line_no;
+        token.token_type = ERROR;
+        return token;
     }
 
+    Fill(howFar);
     int peekIndex = index + howFar - 1;
     if (peekIndex > ((int)tokenList.size()-1)) { // if peeking too far
         Token token;                        // return END_OF_FILE
@@ -6,10 +6,12 @@
 #ifndef __LEXER__H__
 #define __LEXER__H__
 
+#include <istream>
 #include <vector>
 #include <string>
 
 #include "inputbuf.h"
+#include "spscqueue.h"
 
 // Lexer modified for FIRST & FOLLOW project
 
@@ -17,26 +19,37 @@ typedef enum { END_OF_FILE = 0, ARROW, STAR, HASH, ID, ERROR } TokenType;
 
 class Token {
   public:
-    void Print();
-
     std::string lexeme;
     TokenType token_type;
     int line_no;
 };
 
+// tokens travel between pipeline stages in blocks, so that the queue is
+// touched once per block rather than once per token
+typedef std::vector<Token> TokenBlock;
+
 class LexicalAnalyzer {
   public:
     Token GetToken();
     Token peek(int);
-    LexicalAnalyzer();
+    explicit LexicalAnalyzer(std::istream&);
+    LexicalAnalyzer(const char* begin, const char* end, int threads);
+    LexicalAnalyzer(std::istream&, SpscQueue<TokenBlock>& output);
+    explicit LexicalAnalyzer(SpscQueue<TokenBlock>& source);
 
   private:
     std::vector<Token> tokenList;
     Token GetTokenMain();
+    void ReadAllTokens();
     int line_no;
     int index;
     Token tmp;
     InputBuffer input;
+    SpscQueue<TokenBlock>* output;  // tokens go here instead of tokenList
+    SpscQueue<TokenBlock>* source;  // tokenList is filled from here on demand
+    bool sourceDone;
+
+    void Fill(int count);
 
     bool SkipSpace();
     Token ScanId();
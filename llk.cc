@@ -0,0 +1,289 @@
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "llk.h"
+
+int TriePool::newSet()
+{
+    trieNode node;
+    node.symbol = -1;
+    node.child = -1;
+    node.sibling = -1;
+    node.end = false;
+    if(!freeNodes.empty()){
+        int index = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[index] = node;
+        return index;
+    }
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+// frees a node and everything below it
+void TriePool::release(int node)
+{
+    for(int c = nodes[node].child; c != -1; c = nodes[c].sibling){
+        release(c);
+    }
+    freeNodes.push_back(node);
+}
+
+bool TriePool::isEmpty(int node)
+{
+    return !nodes[node].end && nodes[node].child == -1;
+}
+
+// finds or creates the child of node for symbol. The search starts after
+// previous (-1 for the first child) and leaves previous at the child found,
+// so visiting symbols in increasing order walks the children only once
+int TriePool::childOf(int node, int symbol, int& previous, bool& created)
+{
+    int c = previous == -1 ? nodes[node].child : nodes[previous].sibling;
+    while(c != -1 && nodes[c].symbol < symbol){
+        previous = c;
+        c = nodes[c].sibling;
+    }
+    if(c != -1 && nodes[c].symbol == symbol){
+        previous = c;
+        return c;
+    }
+    int added = newSet(); //may move nodes, so link by index afterwards
+    nodes[added].symbol = symbol;
+    nodes[added].sibling = c;
+    if(previous == -1){
+        nodes[node].child = added;
+    } else {
+        nodes[previous].sibling = added;
+    }
+    previous = added;
+    created = true;
+    return added;
+}
+
+bool TriePool::addString(int root, const std::vector<int>& symbols)
+{
+    bool changed = false;
+    int node = root;
+    for(int i = 0; i < symbols.size(); i++){
+        int previous = -1;
+        node = childOf(node, symbols[i], previous, changed);
+    }
+    changed = changed || !nodes[node].end;
+    nodes[node].end = true;
+    return changed;
+}
+
+// adds the strings of from, truncated to depthLeft symbols, to to.
+// returns true if to changed
+bool TriePool::unionInto(int to, int from, int depthLeft)
+{
+    if(isEmpty(from)){
+        return false;
+    }
+    bool changed = false;
+    if(depthLeft == 0 || nodes[from].end){
+        changed = !nodes[to].end;
+        nodes[to].end = true;
+        if(depthLeft == 0){
+            return changed;
+        }
+    }
+    int previous = -1;
+    for(int c = nodes[from].child; c != -1; c = nodes[c].sibling){
+        int target = childOf(to, nodes[c].symbol, previous, changed);
+        changed = unionInto(target, c, depthLeft - 1) || changed;
+    }
+    return changed;
+}
+
+// adds every string of a followed by every string of b, truncated to
+// depthLeft symbols, to to. If b is empty so is the concatenation. returns
+// true if to changed
+bool TriePool::concatInto(int to, int a, int b, int depthLeft)
+{
+    if(isEmpty(b)){
+        return false;
+    }
+    bool changed = false;
+    if(nodes[a].end){
+        if(depthLeft == 0){
+            changed = !nodes[to].end;
+            nodes[to].end = true;
+            return changed;
+        }
+        changed = unionInto(to, b, depthLeft);
+    }
+    int previous = -1;
+    for(int c = nodes[a].child; c != -1; c = nodes[c].sibling){
+        int target = childOf(to, nodes[c].symbol, previous, changed);
+        changed = concatInto(target, c, b, depthLeft - 1) || changed;
+    }
+    return changed;
+}
+
+bool TriePool::intersects(int a, int b)
+{
+    if(nodes[a].end && nodes[b].end){
+        return true;
+    }
+    int x = nodes[a].child;
+    int y = nodes[b].child;
+    while(x != -1 && y != -1){
+        if(nodes[x].symbol < nodes[y].symbol){
+            x = nodes[x].sibling;
+        } else if(nodes[y].symbol < nodes[x].symbol){
+            y = nodes[y].sibling;
+        } else {
+            if(intersects(x, y)){
+                return true;
+            }
+            x = nodes[x].sibling;
+            y = nodes[y].sibling;
+        }
+    }
+    return false;
+}
+
+// FIRST_k of symbols[from..], as a new set the caller releases
+int LLkAnalysis::sequenceFirst(const std::vector<int>& symbols, int from)
+{
+    int result = pool.newSet();
+    pool.nodes[result].end = true; //epsilon
+    for(int i = symbols.size() - 1; i >= from; i--){
+        int longer = pool.newSet();
+        pool.concatInto(longer, first[symbols[i]], result, k);
+        pool.release(result);
+        result = longer;
+    }
+    return result;
+}
+
+LLkAnalysis::LLkAnalysis(const Grammar& grammar, int k) : k(k)
+{
+    g = BuildDenseGrammar(grammar);
+    endMarker = g.names.size();
+    if(g.start < 0){
+        return;
+    }
+
+    for(int i = 0; i < g.names.size(); i++){
+        first.push_back(pool.newSet());
+        follow.push_back(pool.newSet());
+        if(g.isTerminal[i]){
+            pool.addString(first[i], std::vector<int>(1, i));
+        }
+    }
+
+    bool changed = true;
+    while(changed){
+        changed = false;
+        for(int r = 0; r < g.left.size(); r++){
+            int rightFirst = sequenceFirst(g.right[r], 0);
+            changed = pool.unionInto(first[g.left[r]], rightFirst, k) || changed;
+            pool.release(rightFirst);
+        }
+    }
+
+    pool.addString(follow[g.start], std::vector<int>(1, endMarker));
+    changed = true;
+    while(changed){
+        changed = false;
+        for(int r = 0; r < g.left.size(); r++){
+            // walk right to left, extending FIRST_k of the rest of the rule
+            int rest = pool.newSet();
+            pool.nodes[rest].end = true; //epsilon
+            for(int j = g.right[r].size() - 1; j >= 0; j--){
+                int symbol = g.right[r][j];
+                if(!g.isTerminal[symbol]){
+                    changed = pool.concatInto(follow[symbol], rest, follow[g.left[r]], k) || changed;
+                }
+                if(j > 0){
+                    int longer = pool.newSet();
+                    pool.concatInto(longer, first[symbol], rest, k);
+                    pool.release(rest);
+                    rest = longer;
+                }
+            }
+            pool.release(rest);
+        }
+    }
+}
+
+// strong LL(k): for every non-terminal A, the sets FIRST_k(alpha) FOLLOW_k(A)
+// of its rules A -> alpha are pairwise disjoint. Unlike task 5 this does
+// not require the grammar to be free of useless symbols
+bool LLkAnalysis::isStrongLLk()
+{
+    if(g.start < 0){
+        return false;
+    }
+    for(int a = 0; a < g.names.size(); a++){
+        std::vector<int> lookahead;
+        for(int i = 0; i < g.rulesFor[a].size(); i++){
+            int rightFirst = sequenceFirst(g.right[g.rulesFor[a][i]], 0);
+            int set = pool.newSet();
+            pool.concatInto(set, rightFirst, follow[a], k);
+            pool.release(rightFirst);
+            lookahead.push_back(set);
+        }
+        bool conflict = false;
+        for(int i = 0; i < lookahead.size() && !conflict; i++){
+            for(int j = i + 1; j < lookahead.size() && !conflict; j++){
+                conflict = pool.intersects(lookahead[i], lookahead[j]);
+            }
+        }
+        for(int i = 0; i < lookahead.size(); i++){
+            pool.release(lookahead[i]);
+        }
+        if(conflict){
+            return false;
+        }
+    }
+    return true;
+}
+
+// the strings of a set for k = 1, in the form FirstSetAlgo uses
+std::unordered_set<std::string> LLkAnalysis::toStrings(int set, const std::string& empty)
+{
+    std::unordered_set<std::string> strings;
+    if(pool.nodes[set].end){
+        strings.insert(empty);
+    }
+    for(int c = pool.nodes[set].child; c != -1; c = pool.nodes[c].sibling){
+        strings.insert(pool.nodes[c].symbol == endMarker ? "$" : g.names[pool.nodes[c].symbol]);
+    }
+    return strings;
+}
+
+std::unordered_set<std::string> LLkAnalysis::firstSet(const std::string& symbol)
+{
+    auto it = g.ids.find(symbol);
+    if(it == g.ids.end()){
+        return std::unordered_set<std::string>();
+    }
+    return toStrings(first[it->second], "#");
+}
+
+std::unordered_set<std::string> LLkAnalysis::followSet(const std::string& symbol)
+{
+    auto it = g.ids.find(symbol);
+    if(it == g.ids.end()){
+        return std::unordered_set<std::string>();
+    }
+    return toStrings(follow[it->second], "#");
+}
+
+// returns the smallest k up to maxK for which the grammar is strong LL(k),
+// or 0 if there is none
+int MinimumLLk(const Grammar& grammar, int maxK)
+{
+    for(int k = 1; k <= maxK; k++){
+        LLkAnalysis analysis(grammar, k);
+        if(analysis.isStrongLLk()){
+            return k;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+#ifndef __LLK__H__
+#define __LLK__H__
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "grammar.h"
+
+// FIRST_k and FOLLOW_k sets and a strong LL(k) check. Each set of strings
+// of at most k terminals is a prefix trie of integer symbol ids; all tries
+// share one node pool, and concatenation truncated to k is done directly on
+// the tries so the sets never hold more than one node per distinct prefix.
+// A string that is shorter than k either ends with "$" or is epsilon.
+
+struct trieNode {
+    int symbol;
+    int child;    // first child, children are sorted by symbol
+    int sibling;  // next child of the same parent
+    bool end;     // a string of the set ends here
+};
+
+class TriePool{
+    public:
+        int newSet();
+        void release(int node);
+        bool isEmpty(int node);
+        bool addString(int root, const std::vector<int>& symbols);
+        bool unionInto(int to, int from, int depthLeft);
+        bool concatInto(int to, int a, int b, int depthLeft);
+        bool intersects(int a, int b);
+        std::vector<trieNode> nodes;
+    private:
+        std::vector<int> freeNodes;
+        int childOf(int node, int symbol, int& previous, bool& created);
+};
+
+class LLkAnalysis{
+    public:
+        LLkAnalysis(const Grammar& grammar, int k);
+        bool isStrongLLk();
+        std::unordered_set<std::string> firstSet(const std::string& symbol);
+        std::unordered_set<std::string> followSet(const std::string& symbol);
+    private:
+        denseGrammar g;
+        int k;
+        int endMarker;            // symbol id of "$"
+        TriePool pool;
+        std::vector<int> first;   // FIRST_k set of each symbol
+        std::vector<int> follow;  // FOLLOW_k set of each non-terminal
+        int sequenceFirst(const std::vector<int>& symbols, int from);
+        std::unordered_set<std::string> toStrings(int set, const std::string& empty);
+};
+
+int MinimumLLk(const Grammar& grammar, int maxK);
+
+#endif  //__LLK__H__
@@ -0,0 +1,160 @@
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "normalize.h"
+
+suffixTable NormalizeGrammar(Grammar& grammar)
+{
+    suffixTable table;
+    std::unordered_set<std::string> seen;
+    std::vector<rule> unique;
+    for(int i = 0; i < grammar.rule_list.size(); i++){
+        std::string key = RuleToString(grammar.rule_list[i].left, grammar.rule_list[i].right);
+        if(seen.insert(key).second){
+            unique.push_back(grammar.rule_list[i]);
+        }
+    }
+    table.rulesRemoved = grammar.rule_list.size() - unique.size();
+    grammar.rule_list = unique;
+
+    table.g = BuildDenseGrammar(grammar);
+    table.rightSymbols = 0;
+    std::unordered_map<long long, int> interned;
+    for(int r = 0; r < table.g.right.size(); r++){
+        std::vector<int>& right = table.g.right[r];
+        std::vector<int> suffixes(right.size() + 1, -1);
+        for(int j = right.size() - 1; j >= 0; j--){
+            long long key = ((long long) right[j] << 32) | (unsigned) suffixes[j + 1];
+            auto it = interned.find(key);
+            if(it == interned.end()){
+                it = interned.insert(std::make_pair(key, (int) table.symbol.size())).first;
+                table.symbol.push_back(right[j]);
+                table.rest.push_back(suffixes[j + 1]);
+            }
+            suffixes[j] = it->second;
+        }
+        table.rightSymbols += right.size();
+        table.ruleSuffixes.push_back(suffixes);
+    }
+    return table;
+}
+
+typedef std::vector<unsigned long long> symbolSet;
+
+// adds from to to, leaving out the bit skip (-1 for none). returns true if
+// to changed
+static bool AddSymbols(symbolSet& to, const symbolSet& from, int skip)
+{
+    bool changed = false;
+    for(int w = 0; w < to.size(); w++){
+        unsigned long long bits = from[w];
+        if(skip >= 0 && skip / 64 == w){
+            bits &= ~(1ULL << (skip % 64));
+        }
+        changed = changed || (bits & ~to[w]);
+        to[w] |= bits;
+    }
+    return changed;
+}
+
+static bool HasSymbol(const symbolSet& set, int bit)
+{
+    return (set[bit / 64] >> (bit % 64)) & 1;
+}
+
+static void AddSymbol(symbolSet& set, int bit)
+{
+    set[bit / 64] |= 1ULL << (bit % 64);
+}
+
+// the members of a bitset, in the form FirstSetAlgo uses
+static std::unordered_set<std::string> SymbolNames(const denseGrammar& g, const symbolSet& set)
+{
+    int epsilon = g.names.size();
+    std::unordered_set<std::string> members;
+    for(int j = 0; j < g.names.size(); j++){
+        if(HasSymbol(set, j)){
+            members.insert(g.names[j]);
+        }
+    }
+    if(HasSymbol(set, epsilon)){
+        members.insert("#");
+    }
+    if(HasSymbol(set, epsilon + 1)){
+        members.insert("$");
+    }
+    return members;
+}
+
+// FIRST and FOLLOW sets of the non-terminals, computed on the suffix table
+suffixSets SuffixSetAlgo(const suffixTable& table)
+{
+    const denseGrammar& g = table.g;
+    if(g.start < 0){
+        return suffixSets();
+    }
+    int epsilon = g.names.size();
+    int endMarker = epsilon + 1;
+    symbolSet empty((endMarker + 64) / 64, 0);
+
+    std::vector<symbolSet> first(g.names.size(), empty);
+    for(int i = 0; i < g.names.size(); i++){
+        if(g.isTerminal[i]){
+            AddSymbol(first[i], i);
+        }
+    }
+    symbolSet epsilonOnly = empty;
+    AddSymbol(epsilonOnly, epsilon);
+
+    // suffixes are interned after their rest, so one pass in id order sees
+    // the rest of every suffix already updated
+    std::vector<symbolSet> suffixFirst(table.symbol.size(), empty);
+    bool changed = true;
+    while(changed){
+        changed = false;
+        for(int s = 0; s < table.symbol.size(); s++){
+            const symbolSet& head = first[table.symbol[s]];
+            suffixFirst[s] = empty;
+            AddSymbols(suffixFirst[s], head, epsilon);
+            if(HasSymbol(head, epsilon)){
+                AddSymbols(suffixFirst[s], table.rest[s] < 0 ? epsilonOnly : suffixFirst[table.rest[s]], -1);
+            }
+        }
+        for(int r = 0; r < g.left.size(); r++){
+            int whole = table.ruleSuffixes[r][0];
+            changed = AddSymbols(first[g.left[r]], whole < 0 ? epsilonOnly : suffixFirst[whole], -1) || changed;
+        }
+    }
+
+    std::vector<symbolSet> follow(g.names.size(), empty);
+    AddSymbol(follow[g.start], endMarker);
+    changed = true;
+    while(changed){
+        changed = false;
+        for(int r = 0; r < g.left.size(); r++){
+            for(int j = 0; j < g.right[r].size(); j++){
+                int symbol = g.right[r][j];
+                if(g.isTerminal[symbol]){
+                    continue;
+                }
+                int after = table.ruleSuffixes[r][j + 1];
+                const symbolSet& restFirst = after < 0 ? epsilonOnly : suffixFirst[after];
+                changed = AddSymbols(follow[symbol], restFirst, epsilon) || changed;
+                if(HasSymbol(restFirst, epsilon)){
+                    changed = AddSymbols(follow[symbol], follow[g.left[r]], -1) || changed;
+                }
+            }
+        }
+    }
+
+    suffixSets sets;
+    for(int i = 0; i < g.names.size(); i++){
+        if(!g.isTerminal[i]){
+            sets.first[g.names[i]] = SymbolNames(g, first[i]);
+            sets.follow[g.names[i]] = SymbolNames(g, follow[i]);
+        }
+    }
+    return sets;
+}
@@ -0,0 +1,32 @@
+#ifndef __NORMALIZE__H__
+#define __NORMALIZE__H__
+
+#include <vector>
+
+#include "grammar.h"
+
+// Machine-generated grammars repeat whole rules and long right hand side
+// suffixes. NormalizeGrammar() hash-conses the rules, dropping exact
+// duplicates but keeping the first occurrence of each so the output order
+// does not change, and interns every right hand side suffix as a
+// (symbol, rest) pair. FIRST and FOLLOW are then computed on bitsets with
+// FIRST of each distinct suffix evaluated once per pass.
+
+struct suffixTable {
+    denseGrammar g;
+    std::vector<int> symbol;                     // first symbol of each distinct suffix
+    std::vector<int> rest;                       // suffix after it, -1 for the empty suffix
+    std::vector<std::vector<int>> ruleSuffixes;  // suffix starting at each position of each rule
+    int rulesRemoved;
+    int rightSymbols;                            // symbol occurrences on all right hand sides
+};
+
+struct suffixSets {
+    symbolSets first;
+    symbolSets follow;
+};
+
+suffixTable NormalizeGrammar(Grammar& grammar);
+suffixSets SuffixSetAlgo(const suffixTable& table);
+
+#endif  //__NORMALIZE__H__
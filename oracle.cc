@@ -0,0 +1,677 @@
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "earley.h"
+#include "grammar.h"
+#include "lexer.h"
+#include "llk.h"
+#include "normalize.h"
+#include "queryserver.h"
+#include "tasks.h"
+
+// Differential oracle for the analysis engines: generates random grammars
+// (nullable chains, cycles, unreachable and non-generating symbols) written
+// with random whitespace and the occasional invalid character, runs tasks 1
+// to 4 with the original implementations as the reference and with every
+// other engine, checks the recognizer of task 7 against brute force on all
+// short sentences and the LL(k) check of task 9 against brute force FIRST_k
+// and FOLLOW_k sets, and compares the outputs byte for byte. A grammar on which
+// an engine disagrees is shrunk to a minimal reproducer and printed.
+//
+//   oracle [cases] [seed]
+
+// what is compared instead of the task output when the grammar has a
+// syntax error. returns false if it has none
+bool SyntaxErrorOutput(const Grammar& grammar, std::string& output)
+{
+    if(!grammar.syntaxError){
+        return false;
+    }
+    output = "SYNTAX ERROR !!! at line " + std::to_string(grammar.errorLine) + "\n";
+    return true;
+}
+
+std::string BruteForceSentences(const Grammar& grammar);
+std::string BruteForceLLk(const Grammar& grammar);
+
+// the original implementations of tasks 1 to 4, and brute force answers
+// for the recognizer of task 7 and the LL(k) check of task 9
+bool ReferenceEngine(const std::string& text, int task, std::string& output)
+{
+    Grammar grammar(text);
+    if(SyntaxErrorOutput(grammar, output)){
+        return true;
+    }
+    if(task == 7){
+        output = BruteForceSentences(grammar);
+    } else if(task == 9){
+        output = BruteForceLLk(grammar);
+    } else {
+        output = TaskOutput(grammar, task);
+    }
+    return true;
+}
+
+// tasks 1 to 4 on a grammar lexed by the parallel lexer
+bool ParallelLexerEngine(const std::string& text, int task, std::string& output)
+{
+    if(task > 4){
+        return false;
+    }
+    int threads = 2 + text.size() % 3; //vary where the chunks start
+    Grammar grammar(new LexicalAnalyzer(text.data(), text.data() + text.size(), threads));
+    if(SyntaxErrorOutput(grammar, output)){
+        return true;
+    }
+    output = TaskOutput(grammar, task);
+    return true;
+}
+
+// tasks 1 to 4 on a grammar read by the lex, parse and classify pipeline
+bool PipelineEngine(const std::string& text, int task, std::string& output)
+{
+    if(task > 4){
+        return false;
+    }
+    std::istringstream source(text);
+    Grammar grammar(source, 16);
+    if(SyntaxErrorOutput(grammar, output)){
+        return true;
+    }
+    output = TaskOutput(grammar, task);
+    return true;
+}
+
+// tasks 2 to 4 answered through the query server. The server answers from
+// the same FirstSetAlgo, FollowSetAlgo and UsefulRulesAlgo as the
+// reference, so this only checks its query parsing, cache and formatting
+bool QueryServerEngine(const std::string& text, int task, std::string& output)
+{
+    if(task < 2 || task > 4){
+        return false;
+    }
+    Grammar grammar(text);
+    if(SyntaxErrorOutput(grammar, output)){
+        return true;
+    }
+    QueryServer server(grammar);
+    output = "";
+    for(int i = 0; task == 2 && i < grammar.rule_list.size(); i++){
+        std::string ruleText = RuleToString(grammar.rule_list[i].left, grammar.rule_list[i].right);
+        if(server.answer("USEFUL " + ruleText) == "YES"){
+            output += ruleText + "\n";
+        }
+    }
+    for(int i = 0; task > 2 && i < grammar.allSymbols.size(); i++){
+        if(grammar.nonTerminals.count(grammar.allSymbols[i])){
+            std::string query = task == 3 ? "FIRST" : "FOLLOW";
+            output += query + "(" + grammar.allSymbols[i] + ") = " + server.answer(query + " " + grammar.allSymbols[i]) + "\n";
+        }
+    }
+    return true;
+}
+
+// task 2 computed independently of UsefulRulesAlgo: generating symbols by
+// counting, for every rule, the right hand side symbols not yet known to
+// generate, and reachable symbols by a depth-first search over the rules
+// of generating symbols
+bool UsefulRulesEngine(const std::string& text, int task, std::string& output)
+{
+    if(task != 2){
+        return false;
+    }
+    Grammar grammar(text);
+    if(SyntaxErrorOutput(grammar, output)){
+        return true;
+    }
+    const std::vector<rule>& rules = grammar.rule_list;
+
+    std::unordered_map<std::string, std::vector<int>> occurrences; //rules with the symbol on the right
+    std::vector<int> unknown(rules.size(), 0);
+    std::unordered_set<std::string> generating;
+    std::vector<std::string> work;
+    for(int r = 0; r < rules.size(); r++){
+        for(int j = 0; j < rules[r].right.size(); j++){
+            if(grammar.nonTerminals.count(rules[r].right[j])){
+                occurrences[rules[r].right[j]].push_back(r);
+                unknown[r]++;
+            }
+        }
+        if(unknown[r] == 0 && generating.insert(rules[r].left).second){
+            work.push_back(rules[r].left);
+        }
+    }
+    while(!work.empty()){
+        std::string symbol = work.back();
+        work.pop_back();
+        std::vector<int>& uses = occurrences[symbol];
+        for(int i = 0; i < uses.size(); i++){
+            if(--unknown[uses[i]] == 0 && generating.insert(rules[uses[i]].left).second){
+                work.push_back(rules[uses[i]].left);
+            }
+        }
+    }
+
+    std::unordered_set<std::string> reachable;
+    if(generating.count(rules[0].left)){
+        reachable.insert(rules[0].left);
+        work.push_back(rules[0].left);
+    }
+    while(!work.empty()){
+        std::string symbol = work.back();
+        work.pop_back();
+        for(int r = 0; r < rules.size(); r++){
+            if(rules[r].left != symbol || unknown[r] != 0){
+                continue;
+            }
+            for(int j = 0; j < rules[r].right.size(); j++){
+                if(grammar.nonTerminals.count(rules[r].right[j]) && reachable.insert(rules[r].right[j]).second){
+                    work.push_back(rules[r].right[j]);
+                }
+            }
+        }
+    }
+
+    output = "";
+    for(int r = 0; r < rules.size(); r++){
+        if(reachable.count(rules[r].left) && unknown[r] == 0){
+            output += RuleToString(rules[r].left, rules[r].right) + "\n";
+        }
+    }
+    return true;
+}
+
+// returns name, with a number appended if needed, that is not a symbol of
+// the grammar
+std::string FreshSymbol(const Grammar& grammar, const std::string& name)
+{
+    std::string fresh = name;
+    for(int i = 1; grammar.terminals.count(fresh) || grammar.nonTerminals.count(fresh); i++){
+        fresh = name + std::to_string(i);
+    }
+    return fresh;
+}
+
+// tasks 3 and 4 from the FIRST_k and FOLLOW_k tries with k = 1. Tasks 3
+// and 4 give non-generating and unreachable symbols the sets they would
+// have if every symbol derived something and was reachable, while the
+// tries hold the exact (empty) sets. So the tries are built for a grammar
+// in which every non-terminal A also has the rule A -> dead and is
+// reachable through a new start symbol with start -> S and start -> A end,
+// and the markers dead and end are removed from the sets again
+bool LL1TrieEngine(const std::string& text, int task, std::string& output)
+{
+    if(task < 3 || task > 4){
+        return false;
+    }
+    Grammar grammar(text);
+    if(SyntaxErrorOutput(grammar, output)){
+        return true;
+    }
+    std::string start = FreshSymbol(grammar, "start");
+    std::string dead = FreshSymbol(grammar, "dead");
+    std::string end = FreshSymbol(grammar, "end");
+
+    std::vector<rule> rules;
+    rule added;
+    added.left = start;
+    added.right.push_back(grammar.rule_list[0].left);
+    rules.push_back(added);
+    for(int i = 0; i < grammar.allSymbols.size(); i++){
+        if(grammar.nonTerminals.count(grammar.allSymbols[i])){
+            added.right.assign(1, grammar.allSymbols[i]);
+            added.right.push_back(end);
+            rules.push_back(added);
+        }
+    }
+    rules.insert(rules.end(), grammar.rule_list.begin(), grammar.rule_list.end());
+    for(int i = 0; i < grammar.allSymbols.size(); i++){
+        if(grammar.nonTerminals.count(grammar.allSymbols[i])){
+            added.left = grammar.allSymbols[i];
+            added.right.assign(1, dead);
+            rules.push_back(added);
+        }
+    }
+    Grammar padded(GrammarToString(rules));
+
+    LLkAnalysis analysis(padded, 1);
+    symbolSets sets;
+    for(int i = 0; i < grammar.allSymbols.size(); i++){
+        if(grammar.nonTerminals.count(grammar.allSymbols[i])){
+            const std::string& symbol = grammar.allSymbols[i];
+            sets[symbol] = task == 3 ? analysis.firstSet(symbol) : analysis.followSet(symbol);
+            sets[symbol].erase(dead);
+            sets[symbol].erase(end);
+        }
+    }
+    output = task == 3 ? NonTerminalSetsOutput(grammar, sets, "FIRST", "#")
+                       : NonTerminalSetsOutput(grammar, sets, "FOLLOW", "$");
+    return true;
+}
+
+// every sentence of at most a few terminals of the grammar, and one with a
+// word that is not a terminal
+std::vector<std::vector<std::string>> TestSentences(const Grammar& grammar)
+{
+    std::vector<std::string> terminals = SymbolListsAlgo(grammar).terminals;
+    int maxLength = terminals.size() <= 3 ? 4 : 3;
+    std::vector<std::vector<std::string>> sentences(1); //the empty sentence
+    for(int i = 0; i < sentences.size(); i++){
+        for(int t = 0; sentences[i].size() < maxLength && t < terminals.size(); t++){
+            sentences.push_back(sentences[i]);
+            sentences.back().push_back(terminals[t]);
+        }
+    }
+    sentences.push_back(std::vector<std::string>(1, FreshSymbol(grammar, "unknown")));
+    return sentences;
+}
+
+// prints a sentence the way task 7 reads it, with its answer
+std::string SentenceOutput(const std::vector<std::string>& sentence, bool accepted)
+{
+    std::string text = sentence.empty() ? "#" : "";
+    for(int i = 0; i < sentence.size(); i++){
+        text += (i > 0 ? " " : "") + sentence[i];
+    }
+    return text + (accepted ? ": YES\n" : ": NO\n");
+}
+
+typedef std::set<std::vector<std::string>> stringSet;
+
+// every string xy with x in a and y in b. Strings longer than k are cut to
+// k symbols if truncate is set and dropped otherwise
+stringSet Concatenate(const stringSet& a, const stringSet& b, int k, bool truncate)
+{
+    stringSet result;
+    for(auto x = a.begin(); x != a.end(); ++x){
+        for(auto y = b.begin(); y != b.end(); ++y){
+            std::vector<std::string> joined = *x;
+            joined.insert(joined.end(), y->begin(), y->end());
+            if(joined.size() > k){
+                if(!truncate){
+                    continue;
+                }
+                joined.resize(k);
+            }
+            result.insert(joined);
+        }
+    }
+    return result;
+}
+
+// the strings of at most k terminals, or their prefixes of k terminals if
+// truncate is set, that each symbol derives; computed by iterating over
+// the rules until no set changes
+std::map<std::string, stringSet> DerivedStrings(const Grammar& grammar, int k, bool truncate)
+{
+    std::map<std::string, stringSet> derived;
+    for(auto it = grammar.terminals.begin(); it != grammar.terminals.end(); ++it){
+        derived[*it].insert(std::vector<std::string>(1, *it));
+    }
+    bool changed = true;
+    while(changed){
+        changed = false;
+        for(int r = 0; r < grammar.rule_list.size(); r++){
+            stringSet strings;
+            strings.insert(std::vector<std::string>());
+            for(int j = 0; j < grammar.rule_list[r].right.size(); j++){
+                strings = Concatenate(strings, derived[grammar.rule_list[r].right[j]], k, truncate);
+            }
+            stringSet& left = derived[grammar.rule_list[r].left];
+            for(auto it = strings.begin(); it != strings.end(); ++it){
+                changed = left.insert(*it).second || changed;
+            }
+        }
+    }
+    return derived;
+}
+
+// task 7 answered by listing every sentence the start symbol derives
+std::string BruteForceSentences(const Grammar& grammar)
+{
+    std::vector<std::vector<std::string>> sentences = TestSentences(grammar);
+    int maxLength = 0;
+    for(int i = 0; i < sentences.size(); i++){
+        maxLength = std::max(maxLength, (int) sentences[i].size());
+    }
+    stringSet language = DerivedStrings(grammar, maxLength, false)[grammar.rule_list[0].left];
+    std::string output;
+    for(int i = 0; i < sentences.size(); i++){
+        output += SentenceOutput(sentences[i], language.count(sentences[i]) > 0);
+    }
+    return output;
+}
+
+// task 7 with the Earley recognizer
+bool EarleyEngine(const std::string& text, int task, std::string& output)
+{
+    if(task != 7){
+        return false;
+    }
+    Grammar grammar(text);
+    if(SyntaxErrorOutput(grammar, output)){
+        return true;
+    }
+    EarleyRecognizer recognizer(grammar);
+    std::vector<std::vector<std::string>> sentences = TestSentences(grammar);
+    output = "";
+    for(int i = 0; i < sentences.size(); i++){
+        output += SentenceOutput(sentences[i], recognizer.recognize(sentences[i]));
+    }
+    return true;
+}
+
+const int oracleMaxK = 3;
+
+// task 9 with k up to oracleMaxK, from FIRST_k and FOLLOW_k sets of whole
+// strings instead of tries
+std::string BruteForceLLk(const Grammar& grammar)
+{
+    for(int k = 1; k <= oracleMaxK; k++){
+        std::map<std::string, stringSet> first = DerivedStrings(grammar, k, true);
+        std::map<std::string, stringSet> follow;
+        follow[grammar.rule_list[0].left].insert(std::vector<std::string>(1, "$"));
+        bool changed = true;
+        while(changed){
+            changed = false;
+            for(int r = 0; r < grammar.rule_list.size(); r++){
+                const std::vector<std::string>& right = grammar.rule_list[r].right;
+                for(int j = 0; j < right.size(); j++){
+                    if(!grammar.nonTerminals.count(right[j])){
+                        continue;
+                    }
+                    stringSet rest = follow[grammar.rule_list[r].left];
+                    for(int m = right.size() - 1; m > j; m--){
+                        rest = Concatenate(first[right[m]], rest, k, true);
+                    }
+                    for(auto it = rest.begin(); it != rest.end(); ++it){
+                        changed = follow[right[j]].insert(*it).second || changed;
+                    }
+                }
+            }
+        }
+
+        // strong LL(k): the lookaheads of the rules of each non-terminal
+        // are pairwise disjoint
+        bool strong = true;
+        std::map<std::string, stringSet> seen;
+        for(int r = 0; r < grammar.rule_list.size() && strong; r++){
+            const rule& current = grammar.rule_list[r];
+            stringSet lookahead = follow[current.left];
+            for(int m = current.right.size() - 1; m >= 0; m--){
+                lookahead = Concatenate(first[current.right[m]], lookahead, k, true);
+            }
+            stringSet& others = seen[current.left];
+            for(auto it = lookahead.begin(); it != lookahead.end() && strong; ++it){
+                strong = !others.count(*it);
+            }
+            others.insert(lookahead.begin(), lookahead.end());
+        }
+        if(strong){
+            return "k = " + std::to_string(k) + "\n";
+        }
+    }
+    return "NO\n";
+}
+
+// task 9 with the FIRST_k and FOLLOW_k tries
+bool LLkEngine(const std::string& text, int task, std::string& output)
+{
+    if(task != 9){
+        return false;
+    }
+    Grammar grammar(text);
+    if(SyntaxErrorOutput(grammar, output)){
+        return true;
+    }
+    int k = MinimumLLk(grammar, oracleMaxK);
+    output = k > 0 ? "k = " + std::to_string(k) + "\n" : "NO\n";
+    return true;
+}
+
+// tasks 1, 3 and 4 after normalization. Task 2 prints duplicate rules, so
+// it is expected to differ
+bool NormalizedEngine(const std::string& text, int task, std::string& output)
+{
+    if(task == 2 || task > 4){
+        return false;
+    }
+    Grammar grammar(text);
+    if(SyntaxErrorOutput(grammar, output)){
+        return true;
+    }
+    suffixTable table = NormalizeGrammar(grammar);
+    output = task == 1 ? TaskOutput(grammar, 1) : NormalizedSetsOutput(grammar, table, task);
+    return true;
+}
+
+struct oracleEngine {
+    const char* name;
+    bool (*run)(const std::string& text, int task, std::string& output); // false if the task is not supported
+};
+
+oracleEngine oracleEngines[] = {
+    { "parallel lexer", ParallelLexerEngine },
+    { "pipeline", PipelineEngine },
+    { "query server", QueryServerEngine },
+    { "useful rules", UsefulRulesEngine },
+    { "LL(1) tries", LL1TrieEngine },
+    { "normalized suffixes", NormalizedEngine },
+    { "Earley recognizer", EarleyEngine },
+    { "LL(k) tries", LLkEngine },
+};
+
+// grammars with a known answer, checked before the random ones
+struct knownCase {
+    const char* text;
+    int task;
+    const char* expected;
+};
+
+knownCase knownCases[] = {
+    { "S -> a B * S -> a c * B -> b B * #", 9, "k = 1\n" },                  // S -> a B derives nothing
+    { "S -> a A a a * S -> b A b a * A -> b * A -> * #", 9, "k = 3\n" },     // LL(2) but not strong LL(2)
+    { "S -> S a * S -> * #", 9, "NO\n" },                                    // left recursive
+};
+
+std::vector<rule> RandomGrammar(std::mt19937& random)
+{
+    const char* nonTerminalNames[] = { "S", "A", "B", "C", "D", "E", "F", "G" };
+    const char* terminalNames[] = { "a", "b", "c", "d", "e" };
+    int nonTerminalCount = 1 + random() % 8;
+    int terminalCount = 1 + random() % 5;
+    int ruleCount = 1 + random() % 12;
+
+    std::vector<rule> rules;
+    for(int i = 0; i < ruleCount; i++){
+        rule newRule;
+        newRule.left = nonTerminalNames[i == 0 ? 0 : random() % nonTerminalCount];
+        int length = random() % 5;
+        length = length > 3 ? 0 : length; //favor empty right hand sides
+        for(int j = 0; j < length; j++){
+            if(random() % 2){
+                newRule.right.push_back(nonTerminalNames[random() % nonTerminalCount]);
+            } else {
+                newRule.right.push_back(terminalNames[random() % terminalCount]);
+            }
+        }
+        rules.push_back(newRule);
+    }
+
+    // add structures that are easy to get wrong
+    int extra = random() % 4;
+    std::string a = nonTerminalNames[random() % nonTerminalCount];
+    std::string b = nonTerminalNames[random() % nonTerminalCount];
+    rule chain;
+    if(extra == 1){ //nullable chain a -> b b, b -> epsilon
+        chain.left = a;
+        chain.right.push_back(b);
+        chain.right.push_back(b);
+        rules.push_back(chain);
+        chain.left = b;
+        chain.right.clear();
+        rules.push_back(chain);
+    } else if(extra == 2){ //cycle a -> b, b -> a
+        chain.left = a;
+        chain.right.push_back(b);
+        rules.push_back(chain);
+        chain.left = b;
+        chain.right[0] = a;
+        rules.push_back(chain);
+    } else if(extra == 3){ //non-generating a -> terminal a
+        chain.left = a;
+        chain.right.push_back(terminalNames[0]);
+        chain.right.push_back(a);
+        rules.push_back(chain);
+    }
+    return rules;
+}
+
+// writes rules in the input format of the grammar with whitespace and line
+// breaks chosen by layout. Tokens other than two IDs in a row may touch,
+// and about one grammar in ten gets a character that is not part of any
+// token, which the lexer turns into an ERROR token
+std::string RandomText(const std::vector<rule>& rules, unsigned layout)
+{
+    const char* spaces[] = { " ", " ", " ", "  ", "\n", "\t", " \n\n  ", "\r\n" };
+    const char* invalid = "!@$%&-";
+    std::mt19937 random(layout);
+
+    std::vector<std::string> tokens;
+    for(int i = 0; i < rules.size(); i++){
+        tokens.push_back(rules[i].left);
+        tokens.push_back("->");
+        tokens.insert(tokens.end(), rules[i].right.begin(), rules[i].right.end());
+        tokens.push_back("*");
+    }
+    tokens.push_back("#");
+
+    std::string text;
+    for(int i = 0; i < tokens.size(); i++){
+        bool ids = i > 0 && isalpha(tokens[i - 1][0]) && isalpha(tokens[i][0]);
+        if(i > 0 && (ids || random() % 3)){
+            text += spaces[random() % 8];
+        }
+        text += tokens[i];
+    }
+    if(random() % 10 == 0){
+        text.insert(random() % (text.size() + 1), 1, invalid[random() % 6]);
+    }
+    return text + (random() % 2 ? "\n" : "");
+}
+
+// returns true if the engine's output differs from the reference's
+bool Differs(const oracleEngine& engine, const std::vector<rule>& rules, unsigned layout, int task, std::string& expected, std::string& actual)
+{
+    std::string text = RandomText(rules, layout);
+    ReferenceEngine(text, task, expected);
+    return engine.run(text, task, actual) && actual != expected;
+}
+
+// removes rules and right hand side symbols while the difference remains
+std::vector<rule> Shrink(const oracleEngine& engine, std::vector<rule> rules, unsigned layout, int task)
+{
+    std::string expected, actual;
+    bool changed = true;
+    while(changed){
+        changed = false;
+        for(int i = 0; i < rules.size() && rules.size() > 1; i++){
+            std::vector<rule> smaller = rules;
+            smaller.erase(smaller.begin() + i);
+            if(Differs(engine, smaller, layout, task, expected, actual)){
+                rules = smaller;
+                changed = true;
+                i--;
+            }
+        }
+        for(int i = 0; i < rules.size(); i++){
+            for(int j = 0; j < rules[i].right.size(); j++){
+                std::vector<rule> smaller = rules;
+                smaller[i].right.erase(smaller[i].right.begin() + j);
+                if(Differs(engine, smaller, layout, task, expected, actual)){
+                    rules = smaller;
+                    changed = true;
+                    j--;
+                }
+            }
+        }
+    }
+    return rules;
+}
+
+// returns the exit status: 0 if every engine agreed with the reference
+int RunOracle(int cases, unsigned seed)
+{
+    std::mt19937 random(seed);
+    int engineCount = sizeof(oracleEngines) / sizeof(oracleEngines[0]);
+    long long comparisons = 0;
+    int syntaxErrors = 0;
+
+    for(int c = 0; c < sizeof(knownCases) / sizeof(knownCases[0]); c++){
+        const knownCase& known = knownCases[c];
+        std::string actual;
+        ReferenceEngine(known.text, known.task, actual);
+        for(int e = -1; e < engineCount; e++){ //-1 is the reference
+            if(e >= 0 && !oracleEngines[e].run(known.text, known.task, actual)){
+                continue;
+            }
+            comparisons++;
+            if(actual != known.expected){
+                std::cout << "MISMATCH: " << (e < 0 ? "reference" : oracleEngines[e].name)
+                          << ", task " << known.task << ", known grammar\n";
+                std::cout << "grammar:\n" << known.text << "\n";
+                std::cout << "expected:\n" << known.expected << "\nactual:\n" << actual << "\n";
+                return 1;
+            }
+        }
+    }
+
+    for(int c = 0; c < cases; c++){
+        std::vector<rule> rules = RandomGrammar(random);
+        unsigned layout = random();
+        std::string text = RandomText(rules, layout);
+        syntaxErrors += Grammar(text).syntaxError;
+        int tasks[] = { 1, 2, 3, 4, 7, 9 };
+        for(int t = 0; t < sizeof(tasks) / sizeof(tasks[0]); t++){
+            int task = tasks[t];
+            std::string expected;
+            ReferenceEngine(text, task, expected);
+            for(int e = 0; e < engineCount; e++){
+                std::string actual;
+                if(!oracleEngines[e].run(text, task, actual)){
+                    continue;
+                }
+                comparisons++;
+                if(actual == expected){
+                    continue;
+                }
+                std::vector<rule> minimal = Shrink(oracleEngines[e], rules, layout, task);
+                Differs(oracleEngines[e], minimal, layout, task, expected, actual);
+                std::cout << "MISMATCH: engine \"" << oracleEngines[e].name << "\", task " << task
+                          << ", seed " << seed << ", case " << c << "\n";
+                std::cout << "grammar:\n" << RandomText(minimal, layout) << "\n";
+                std::cout << "expected:\n" << expected << "\nactual:\n" << actual << "\n";
+                return 1;
+            }
+        }
+    }
+    std::cout << "oracle: " << cases << " grammars (" << syntaxErrors << " with syntax errors), "
+              << comparisons << " comparisons, no differences\n";
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    int cases = argc > 1 ? atoi(argv[1]) : 1000;
+    unsigned seed = argc > 2 ? strtoul(argv[2], NULL, 10) : std::random_device()();
+    return RunOracle(cases, seed);
+}
@@ -4,510 +4,265 @@
  * Do not share this file with anyone
  */
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
 #include <vector>
 #include <string>
-#include <unordered_set>
-#include <unordered_map>
-#include "lexer.h"
-
-struct rule {
-    std::string left;
-    std::vector<std::string> right;
-};
-
-class Grammar{
-    public:
-        Grammar();
-        std::vector<rule> rule_list;
-        std::unordered_set<std::string> nonTerminals;
-        std::unordered_set<std::string> terminals;
-        std::vector<std::string> allSymbols;
-    private:
-        LexicalAnalyzer* lexer;
-        void parse_input();
-        void parse_Grammar();
-        void parse_Rule_list();
-        void parse_Id_list();
-        void parse_Rule();
-        void parse_Right_hand_side();
-        void syntax_error();
-        Token expect(TokenType token);
-};
-
-Grammar* gram; //global variable to store the grammar
-
-Grammar::Grammar()
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "grammar.h"
+#include "earley.h"
+#include "llk.h"
+#include "normalize.h"
+#include "inputbuf.h"
+#include "queryserver.h"
+#include "tasks.h"
+
+// read grammar from standard input, or from fileName if it is not NULL.
+// pipelined runs lexing, parsing and classification concurrently; otherwise
+// with more than one thread the input is memory-mapped and lexed in
+// parallel. returns NULL if the file cannot be opened
+Grammar* ReadGrammar(const char* fileName, int threads, bool pipelined)
 {
-    lexer = new LexicalAnalyzer();
-    parse_input();
-}
-
-// read grammar
-void ReadGrammar()
-{
-    gram = new Grammar();
-}
-
-void Grammar::parse_input()
-{
-    parse_Grammar();
-    expect(END_OF_FILE);
-}
-
-void Grammar::syntax_error() {
-    std::cout << "SYNTAX ERROR !!!\n";
-    exit(1);
-}
-
-void Grammar::parse_Grammar(){
-    parse_Rule_list();
-    expect(HASH);
-}
-
-void Grammar::parse_Rule_list(){
-    parse_Rule();
-    Token t = lexer->peek(1);
-    if(t.token_type == HASH){
-        return; //stop parsing RULE_LIST
-    } else {
-        parse_Rule_list(); //recurse until HASH is detected.
-    }
-}
-
-void Grammar::parse_Id_list(){
-    Token t = expect(ID);
-    
-    rule_list[rule_list.size() - 1].right.push_back(t.lexeme); //push to right hand side of the last rule
-
-    // add it to the allSymbols list if we've never seen it before
-    if (!nonTerminals.count(t.lexeme) && !terminals.count(t.lexeme)) {
-        allSymbols.push_back(t.lexeme);
-        terminals.insert(t.lexeme);
+    if (pipelined) {
+        std::ifstream file;
+        if (fileName != NULL) {
+            file.open(fileName);
+            if (!file.is_open()) {
+                return NULL;
+            }
+        }
+        return new Grammar(fileName == NULL ? std::cin : file, 64);
     }
 
-    Token y = lexer->peek(1);
-    if(y.token_type == STAR){
-        return; //stop if there are no more ID Lists.
-    } else {
-        parse_Id_list(); //recurse.
+    if (threads > 1) {
+        int fd = fileName == NULL ? 0 : open(fileName, O_RDONLY);
+        if (fd < 0) {
+            return NULL;
+        }
+        MappedInput input(fd);
+        Grammar* grammar = new Grammar(new LexicalAnalyzer(input.begin(), input.end(), threads));
+        if (fd != 0) {
+            close(fd);
+        }
+        return grammar;
     }
-}
-
-void Grammar::parse_Rule(){
-
-    // As we parse this rule, we should add it to rule_list.
 
-    Token t = expect(ID);
-    
-    rule newRule;
-    newRule.left = t.lexeme;
-    if(terminals.count(t.lexeme)){ //if we wrongly classify a symbol as a terminal when it is not, remove it from terminals and add to non-terminals
-        terminals.erase(t.lexeme);
-        nonTerminals.insert(t.lexeme);
+    if (fileName == NULL) {
+        return new Grammar(std::cin);
     }
-    // add it to the allSymbols list and non-terminals list if we've never seen it before
-    if (!nonTerminals.count(t.lexeme) && !terminals.count(t.lexeme)) {
-        allSymbols.push_back(t.lexeme);
-        nonTerminals.insert(t.lexeme);
+    std::ifstream file(fileName);
+    if (!file.is_open()) {
+        return NULL;
     }
-
-    //adds new rule to rule list.
-    rule_list.push_back(newRule); 
-
-    expect(ARROW);
-
-    parse_Right_hand_side();
-
-    expect(STAR);
-
+    return new Grammar(file);
 }
 
-void Grammar::parse_Right_hand_side(){
-    Token t = lexer->peek(1);
-    if(t.token_type == STAR){
-        return;
-    } else {
-        parse_Id_list(); //parse ID List if it's not a STAR
-    }
+// Task 5
+void CheckIfGrammarHasPredictiveParser()
+{
+    
 }
 
-Token Grammar::expect(TokenType token){
-    Token tok = lexer->GetToken();
-    if(tok.token_type == token){
-        return tok;
-    } else {
-        syntax_error();
-    }
-}
+// Task 6
+//
+// Serves the query server of queryserver.h on standard input or on a Unix
+// socket. QUIT ends the session.
 
-// Task 1
-void printTerminalsAndNoneTerminals()
+// answers queries from standard input until QUIT or end of input
+void ServeStandardInput(QueryServer& server)
 {
-    for(int i = 0; i < gram->allSymbols.size(); i++){ //print terminals
-        if(gram->terminals.count(gram->allSymbols[i])){
-           std::cout << gram->allSymbols[i] + " ";
+    std::string line;
+    while(std::getline(std::cin, line)){
+        if(line.find_first_not_of(" \t\r") == std::string::npos){
+            continue;
         }
-    }
-
-    for(int j = 0; j < gram->allSymbols.size(); j++){ //print non-terminals
-        if(gram->nonTerminals.count(gram->allSymbols[j])){
-            std::cout << gram->allSymbols[j] + " ";
+        if(line.substr(0, 4) == "QUIT"){
+            break;
         }
+        std::cout << server.answer(line) << '\n';
+        std::cout.flush();
     }
 }
 
-// Task 2
-void RemoveUselessSymbols()
+// sends all of data to client. returns false if the client has gone away;
+// MSG_NOSIGNAL keeps that from raising SIGPIPE and ending the server
+bool SendAll(int client, const std::string& data)
 {
-    std::unordered_map<std::string, bool> generatingSymbols; //create a map to check for generating symbols
-    std::unordered_set<std::string> terminals = gram->terminals;
-    std::unordered_set<std::string> nonTerminals = gram->nonTerminals;
-    std::vector<rule> rule_list = gram->rule_list;
-
-    // "#" to represent epsilon
-    generatingSymbols["#"] = true;
-
-    for (auto it = terminals.begin(); it != terminals.end(); ++it) { //all terminals are generating
-        generatingSymbols[*it] = true;
-    }
-
-    for(auto jt = nonTerminals.begin(); jt != nonTerminals.end(); ++jt){ //set all non terminals to false for now.
-        generatingSymbols[*jt] = false;
-    }
-
-    bool change = true;
-    while (change) {
-        change = false;
-        for (int i = 0; i < rule_list.size(); i++){
-            rule currentRule = rule_list[i];
-            bool ruleIsGenerating = true;
-            for (int j = 0; j < currentRule.right.size(); j++){
-                if(!generatingSymbols[currentRule.right[j]]){
-                    ruleIsGenerating = false;
-                    break;
-                }
-            } 
-            if(ruleIsGenerating && !generatingSymbols[currentRule.left]){ //sets it only once
-                generatingSymbols[currentRule.left] = true;
-                change = true;
-            }
-        }
-    }
-
-    std::vector<rule> RulesGen; //new vector
-    for(int i = 0; i < rule_list.size(); i++){
-        if(!generatingSymbols[rule_list[i].left]) {
+    size_t sent = 0;
+    while(sent < data.size()){
+        ssize_t n = send(client, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if(n < 0 && errno == EINTR){
             continue;
         }
-        
-        bool rightGen = true;
-
-        for(int j = 0; j < rule_list[i].right.size(); j++){
-            if(!generatingSymbols[rule_list[i].right[j]]){
-                rightGen = false;
-                break;
-            }
-        }
-
-        if(rightGen){
-            RulesGen.push_back(rule_list[i]);
+        if(n <= 0){
+            return false;
         }
+        sent += n;
     }
+    return true;
+}
 
-    std::unordered_map<std::string, bool> reachableSymbols;
-
-    //set all terminals to not reachable for now
-    for (auto it = terminals.begin(); it != terminals.end(); ++it) {
-        reachableSymbols[*it] = false;
-    }
-    
-    //set all non terminals to false for now
-    for(auto jt = nonTerminals.begin(); jt != nonTerminals.end(); ++jt){
-        reachableSymbols[*jt] = false;
+// answers queries from clients connecting to a Unix socket at path, one
+// client at a time. QUIT closes the client's connection. An existing socket
+// at path is replaced, any other file is not. returns false if the socket
+// cannot be set up or accepting a client fails
+bool ServeSocket(QueryServer& server, const char* path)
+{
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0){
+        return false;
     }
-
-    // if its the start symbol, set it to true.
-    reachableSymbols[rule_list[0].left] = true; 
-
-    change = true;
-    while(change){
-        change = false;
-        for(int i = 0; i < RulesGen.size(); i++){
-            rule currentRule = RulesGen[i];
-            if(reachableSymbols[currentRule.left]) {
-                for(int j = 0; j < RulesGen[i].right.size(); j++){
-                    if(!reachableSymbols[currentRule.right[j]]) //set to true if we haven't already
-                    {
-                        reachableSymbols[currentRule.right[j]] = true;
-                        change = true;
-                    }
-                }
-            }
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    struct stat existing;
+    if(lstat(path, &existing) == 0){
+        if(!S_ISSOCK(existing.st_mode)){ //never replace anything but a stale socket
+            close(listener);
+            return false;
         }
+        unlink(path);
     }
-
-    std::vector<rule> usefulRules;
-
-    for(int i = 0; i < RulesGen.size(); i++){
-        if(!reachableSymbols[RulesGen[i].left]){
-            continue;
-        }
-
-        bool rightReach = true;
-
-        for(int j = 0; j < RulesGen[i].right.size(); j++){
-            if(!reachableSymbols[RulesGen[i].right[j]]){
-                rightReach = false;
-                break;
-            }
-        }
-
-        if(rightReach){
-            usefulRules.push_back(RulesGen[i]);
-        }
+    if(bind(listener, (struct sockaddr*) &address, sizeof(address)) < 0 || listen(listener, 16) < 0){
+        close(listener);
+        return false;
     }
 
-    for(int i = 0; i < usefulRules.size(); i++){
-        std::cout << usefulRules[i].left + " -> ";
-        if(usefulRules[i].right.empty()){
-            std::cout << "#";
-        } else {
-            for (int j = 0; j < usefulRules[i].right.size(); j++){
-                std::cout << usefulRules[i].right[j];
-                if (j != usefulRules[i].right.size()-1){
-                    std::cout << " ";
-                }
+    while(true){
+        int client = accept(listener, NULL, NULL);
+        if(client < 0){
+            if(errno == EINTR){
+                continue;
             }
+            close(listener);
+            return false;
         }
-        std::cout << "\n";
-    }
-
-}
-
-std::unordered_map<std::string, std::unordered_set<std::string>> FirstSetAlgo(){
-    std::unordered_map<std::string, std::unordered_set<std::string>> firstSets; //map of first sets
-    std::unordered_set<std::string> terminals = gram->terminals;
-    std::unordered_set<std::string> nonTerminals = gram->nonTerminals;
-    std::vector<rule> ruleList = gram->rule_list;
-
-    for(auto jt = nonTerminals.begin(); jt != nonTerminals.end(); ++jt){
-        firstSets[*jt] = {}; //set first sets of nonterminals as empty.
-    }
-
-    for(auto it = terminals.begin(); it != terminals.end(); ++it){
-        firstSets[*it] = {*it};
-    }
-    
-    bool changed = true;
-    while(changed){ //loop until something is changed
-        changed = false;
-        for(int i = 0; i < ruleList.size(); i++){ 
-
-            // A -> B
-
-            int initialSize = firstSets[ruleList[i].left].size();
-
-            if(ruleList[i].right.empty()){ //check if RHS is empty
-                firstSets[ruleList[i].left].insert("#"); //add epsilon in first of RHS
-            }
-            else{
-                for (int j = 0; j < ruleList[i].right.size(); j++) { //loop through all symbols in RHS
-                    if(terminals.count(ruleList[i].right[j])){
-                        firstSets[ruleList[i].left].insert(ruleList[i].right[j]); //add first of that terminal to first set of LHS
-                        break;
-                    } else {
-                        bool hasEpsilon = false;
-                        for(auto iter = firstSets[ruleList[i].right[j]].begin(); iter != firstSets[ruleList[i].right[j]].end(); ++iter){ //rule 3
-                            // insert as long as it's not epsilon
-                            if (*iter != "#") {
-                                firstSets[ruleList[i].left].insert(*iter);
-                            } else {
-                                hasEpsilon = true;
-                            }
-                        }
-
-                        if (!hasEpsilon) { //rule 4
-                            break;
-                        } else {
-                            if(j == ruleList[i].right.size() - 1){
-                                firstSets[ruleList[i].left].insert("#"); //rule 5
-                            }
-                            continue;
-                        }
-                    }
+        std::string pending;
+        char buffer[4096];
+        bool quit = false;
+        ssize_t n;
+        while(!quit && (n = read(client, buffer, sizeof(buffer))) > 0){
+            pending.append(buffer, n);
+            size_t end;
+            while((end = pending.find('\n')) != std::string::npos){
+                std::string line = pending.substr(0, end);
+                pending.erase(0, end + 1);
+                if(line.find_first_not_of(" \t\r") == std::string::npos){
+                    continue;
                 }
-            }
-            int finalSize = firstSets[ruleList[i].left].size();
-            if (finalSize != initialSize){
-                changed = true;
-            }
-        }
-    }
-    return firstSets;
-}
-
-// Task 3
-void CalculateFirstSets()
-{
-    std::unordered_map<std::string, std::unordered_set<std::string>> firstSets = FirstSetAlgo(); //map of first sets
-    std::unordered_set<std::string> terminals = gram->terminals;
-    std::unordered_set<std::string> nonTerminals = gram->nonTerminals;
-    std::vector<rule> ruleList = gram->rule_list;
-
-    std::vector<std::string> allSymbols = gram->allSymbols;
-
-    for(int i = 0; i < allSymbols.size(); i++){
-        if(nonTerminals.count(allSymbols[i])) {
-            std::cout << "FIRST(" + allSymbols[i] + ") = ";
-            std::string stringToPrint = "{ ";
-            if(!firstSets[allSymbols[i]].empty()){
-            
-                if(firstSets[allSymbols[i]].count("#")){
-                    stringToPrint += "#, ";
+                if(line.substr(0, 4) == "QUIT"){
+                    quit = true;
+                    break;
                 }
-
-                for(int j = 0; j < allSymbols.size(); j++){
-                    if(firstSets[allSymbols[i]].count(allSymbols[j])){
-                        stringToPrint += allSymbols[j] + ", ";
-                    }
+                std::string reply = server.answer(line) + "\n";
+                if(!SendAll(client, reply)){
+                    quit = true;
+                    break;
                 }
-
-                stringToPrint = stringToPrint.substr(0, stringToPrint.length()-2);
             }
-
-            stringToPrint += " }";
-
-            std::cout << stringToPrint + '\n';
-
         }
-        
+        close(client);
     }
-
 }
 
-// Task 4
-void CalculateFollowSets()
+// returns false if serving on the socket fails
+bool RunQueryServer(const Grammar& grammar, const char* socketPath)
 {
-   
-    std::unordered_map<std::string, std::unordered_set<std::string>> firstSets = FirstSetAlgo(); //map of first sets
-    
-    std::unordered_map<std::string, std::unordered_set<std::string>> followSets;
-    std::unordered_set<std::string> terminals = gram->terminals;
-    std::unordered_set<std::string> nonTerminals = gram->nonTerminals;
-    std::vector<std::string> allSymbols = gram->allSymbols;
-    std::vector<rule> ruleList = gram->rule_list;
-
-    
-
-    for(auto it = nonTerminals.begin(); it != nonTerminals.end(); ++it){
-        followSets[*it] = {}; //sets all nonterminals as empty for now
+    QueryServer server(grammar);
+    if(socketPath == NULL){
+        ServeStandardInput(server);
+        return true;
     }
-    
-    followSets[ruleList[0].left] = { "$" }; //set FOLLOW of first rule as $
-
-    bool changed = true;
-    while(changed){
-        changed = false;
-        for(int i = 0; i < ruleList.size(); i++){ //loop through all rules
-            for(int j = ruleList[i].right.size() - 1; j >= 0; j--){
-                if(nonTerminals.count(ruleList[i].right[j])){
-                    int initialSize = followSets[ruleList[i].right[j]].size();
-                    
-                    for (auto it = followSets[ruleList[i].left].begin(); it != followSets[ruleList[i].left].end(); ++it){
-                        followSets[ruleList[i].right[j]].insert(*it); //create array of follow sets of LHS. Loop through array and add symbols in Follow set of current RHS
-                    }
-
-                    int finalSize = followSets[ruleList[i].right[j]].size();
-
-                    if(initialSize != finalSize){
-                        changed = true;
-                    }
-                    
-                }
+    return ServeSocket(server, socketPath);
+}
 
-                if(firstSets[ruleList[i].right[j]].count("#")){
-                    continue;
-                } else {
-                    break;
-                }
-            }
-            for(int k = 0; k < ruleList[i].right.size(); k++){
-                if(!nonTerminals.count(ruleList[i].right[k])){
-                    continue;
-                } else {
-                    for(int l = k + 1; l < ruleList[i].right.size(); l++){
-                        
-                        int initialSize = followSets[ruleList[i].right[k]].size();
-                        bool epsilonPresent = false;
-                        // add everything in the first set of the symbol at l 
-                        // into the follow set of the symbol at k
-                        std::unordered_set<std::string> firstSetofL = firstSets[ruleList[i].right[l]];
-                        for(auto it = firstSetofL.begin(); it != firstSetofL.end(); ++it){
-                            if(*it != "#"){
-                                followSets[ruleList[i].right[k]].insert(*it);
-                            } else {
-                                epsilonPresent = true;
-                            }
-                        }
-                        
-                        int finalSize = followSets[ruleList[i].right[k]].size();
-
-                        if(initialSize != finalSize){
-                            changed = true;
-                        }
-
-                        if(!epsilonPresent){
-                            break;
-                        }
-                    }
-                }
+// Task 7
+// reads one sentence of terminals per line from standard input and prints
+// YES if the grammar derives it and NO otherwise. with stats, the time
+// taken for each sentence is printed to standard error
+void RunEarleyRecognizer(const Grammar& grammar, bool stats)
+{
+    EarleyRecognizer recognizer(grammar);
+    std::string line;
+    while(std::getline(std::cin, line)){
+        std::istringstream words(line);
+        std::vector<std::string> sentence;
+        std::string word;
+        while(words >> word){
+            if(word != "#"){ //"#" is the empty sentence
+                sentence.push_back(word);
             }
-            
         }
-    }
 
-    for(int i = 0; i < allSymbols.size(); i++){
-        if(nonTerminals.count(allSymbols[i])) {
-            std::cout << "FOLLOW(" + allSymbols[i] + ") = ";
-            std::string stringToPrint = "{ ";
-            if(!followSets[allSymbols[i]].empty()){
-            
-                if(followSets[allSymbols[i]].count("$")){
-                    stringToPrint += "$, ";
-                }
-
-                for(int j = 0; j < allSymbols.size(); j++){
-                    if(followSets[allSymbols[i]].count(allSymbols[j])){
-                        stringToPrint += allSymbols[j] + ", ";
-                    }
-                }
-
-                stringToPrint = stringToPrint.substr(0, stringToPrint.length()-2);
-            }
-
-            stringToPrint += " }";
-
-            std::cout << stringToPrint + '\n';
+        auto begin = std::chrono::steady_clock::now();
+        bool accepted = recognizer.recognize(sentence);
+        auto end = std::chrono::steady_clock::now();
 
+        std::cout << (accepted ? "YES" : "NO") << '\n';
+        if(stats){
+            std::cerr << "earley: " << sentence.size() << " tokens, "
+                      << recognizer.itemCount << " items, "
+                      << std::chrono::duration<double, std::milli>(end - begin).count() << " ms\n";
         }
-        
     }
-    
 }
 
-// Task 5
-void CheckIfGrammarHasPredictiveParser()
+// Task 8 was the differential oracle; it is now built on its own by
+// "make oracle" and run by "make check". The task numbers are kept.
+
+// Task 9
+// with k > 0 prints YES if the grammar is strong LL(k) and NO otherwise.
+// with k = 0 prints the smallest k up to maxK for which it is, or NO
+void CheckIfGrammarIsLLk(const Grammar& grammar, int k)
 {
-    
+    const int maxK = 8;
+    if(k > 0){
+        LLkAnalysis analysis(grammar, k);
+        std::cout << (analysis.isStrongLLk() ? "YES" : "NO") << "\n";
+        return;
+    }
+    k = MinimumLLk(grammar, maxK);
+    if(k > 0){
+        std::cout << "k = " << k << "\n";
+    } else {
+        std::cout << "NO\n";
+    }
 }
 
 int main (int argc, char* argv[])
 {
     int task;
+    int threads = 1;
+    bool stats = false;
+    bool normalize = false;
+    bool pipelined = false;
+    std::vector<char*> args; // arguments other than options
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-j", 2) == 0) { // -jN lexes the input on N threads
+            threads = atoi(argv[i] + 2);
+        } else if (strcmp(argv[i], "-s") == 0) { // -s prints statistics to standard error
+            stats = true;
+        } else if (strcmp(argv[i], "-n") == 0) { // -n removes duplicate rules and shares suffixes
+            normalize = true;
+        } else if (strcmp(argv[i], "-p") == 0) { // -p lexes, parses and classifies concurrently
+            pipelined = true;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
 
-    if (argc < 2)
+    if (args.size() < 1)
     {
         std::cout << "Error: missing argument\n";
         return 1;
@@ -518,33 +273,80 @@ int main (int argc, char* argv[])
        and the first argument to your program is stored in argv[1]
      */
 
-    task = atoi(argv[1]);
-    
-    ReadGrammar();  // Reads the input grammar from standard input
-                    // and represent it internally in data structures
-                    // ad described in project 2 presentation file
+    task = atoi(args[0]);
+
+    // the query server and the recognizer read queries and sentences from
+    // standard input, so their grammar comes from the file named by the
+    // second argument
+    const char* grammarFile = NULL;
+    if (task == 6 || task == 7) {
+        if (args.size() < 2) {
+            std::cout << "Error: missing grammar file\n";
+            return 1;
+        }
+        grammarFile = args[1];
+    }
+
+    Grammar* grammar = ReadGrammar(grammarFile, threads, pipelined);  // Reads the input grammar from standard input
+                                               // and represent it internally in data structures
+                                               // ad described in project 2 presentation file
+    if (grammar == NULL) {
+        std::cout << "Error: cannot open grammar file " << grammarFile << "\n";
+        return 1;
+    }
+    if (grammar->syntaxError) {
+        std::cout << "SYNTAX ERROR !!!\n";
+        delete grammar;
+        return 1;
+    }
 
+    suffixTable table;
+    if (normalize) {
+        table = NormalizeGrammar(*grammar);
+        std::cerr << "normalize: " << table.rulesRemoved << " duplicate rules removed, "
+                  << table.rightSymbols << " right hand side symbols share "
+                  << table.symbol.size() << " distinct suffixes\n";
+    }
+
+    int status = 0;
     switch (task) {
-        case 1: printTerminalsAndNoneTerminals();
+        case 1: std::cout << TerminalsAndNoneTerminals(*grammar);
             break;
 
-        case 2: RemoveUselessSymbols();
+        case 2: std::cout << RemoveUselessSymbols(*grammar);
             break;
 
-        case 3: CalculateFirstSets();
+        case 3: if (normalize) std::cout << NormalizedSetsOutput(*grammar, table, 3);
+                else std::cout << CalculateFirstSets(*grammar);
             break;
 
-        case 4: CalculateFollowSets();
+        case 4: if (normalize) std::cout << NormalizedSetsOutput(*grammar, table, 4);
+                else std::cout << CalculateFollowSets(*grammar);
             break;
 
         case 5: CheckIfGrammarHasPredictiveParser();
             break;
 
+        case 6: if (!RunQueryServer(*grammar, args.size() > 2 ? args[2] : NULL)) {
+                    std::cout << "Error: cannot listen on " << args[2] << "\n";
+                    status = 1;
+                }
+            break;
+
+        case 7: RunEarleyRecognizer(*grammar, stats);
+            break;
+
+        // task 8, the oracle, is not part of this program
+
+        case 9: CheckIfGrammarIsLLk(*grammar, args.size() > 1 ? atoi(args[1]) : 0);
+            break;
+
         default:
             std::cout << "Error: unrecognized task number " << task << "\n";
             break;
     }
-    return 0;
+    delete grammar;
+    return status;
 }
 
 
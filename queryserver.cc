@@ -0,0 +1,132 @@
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "queryserver.h"
+
+FirstCache::FirstCache(int capacity) : capacity(capacity)
+{
+}
+
+bool FirstCache::lookup(const std::string& key, firstEntry& entry)
+{
+    auto it = index.find(key);
+    if(it == index.end()){
+        return false;
+    }
+    entries.splice(entries.begin(), entries, it->second); //move to the front
+    entry = it->second->second;
+    return true;
+}
+
+void FirstCache::insert(const std::string& key, const firstEntry& entry)
+{
+    if(index.count(key)){
+        return;
+    }
+    if(entries.size() == capacity){ //evict the least recently used entry
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    entries.push_front(std::make_pair(key, entry));
+    index[key] = entries.begin();
+}
+
+QueryServer::QueryServer(const Grammar& grammar) : g(grammar), cache(4096)
+{
+    firstSets = FirstSetAlgo(g);
+    followSets = FollowSetAlgo(g, firstSets);
+
+    for(int i = 0; i < g.rule_list.size(); i++){
+        allRules.insert(RuleToString(g.rule_list[i].left, g.rule_list[i].right));
+    }
+    std::vector<rule> useful = UsefulRulesAlgo(g);
+    for(int i = 0; i < useful.size(); i++){
+        usefulRules.insert(RuleToString(useful[i].left, useful[i].right));
+    }
+}
+
+// computes FIRST of a sentential form from the FIRST sets of its symbols.
+// returns false and sets error if a symbol is not in the grammar
+bool QueryServer::firstOfSequence(const std::vector<std::string>& symbols, firstEntry& entry, std::string& error)
+{
+    std::string key;
+    for(int i = 0; i < symbols.size(); i++){
+        key += symbols[i] + " ";
+    }
+    if(cache.lookup(key, entry)){
+        return true;
+    }
+
+    for(int i = 0; i < symbols.size(); i++){
+        if(!firstSets.count(symbols[i])){
+            error = "ERROR: unknown symbol " + symbols[i];
+            return false;
+        }
+    }
+
+    std::unordered_set<std::string> first;
+    bool nullable = true;
+    for(int i = 0; i < symbols.size() && nullable; i++){
+        std::unordered_set<std::string>& firstOfSymbol = firstSets[symbols[i]];
+        nullable = false;
+        for(auto iter = firstOfSymbol.begin(); iter != firstOfSymbol.end(); ++iter){
+            if(*iter != "#"){
+                first.insert(*iter);
+            } else {
+                nullable = true;
+            }
+        }
+    }
+    if(nullable){
+        first.insert("#");
+    }
+
+    entry.text = SetToString(g, first, "#");
+    entry.nullable = nullable;
+    cache.insert(key, entry);
+    return true;
+}
+
+std::string QueryServer::answer(const std::string& line)
+{
+    std::istringstream words(line);
+    std::string command;
+    words >> command;
+
+    std::vector<std::string> args;
+    std::string word;
+    while(words >> word){
+        if(word != "#"){ //"#" is the empty sentential form
+            args.push_back(word);
+        }
+    }
+
+    if(command == "FIRST" || command == "NULLABLE"){
+        firstEntry entry;
+        std::string error;
+        if(!firstOfSequence(args, entry, error)){
+            return error;
+        }
+        if(command == "FIRST"){
+            return entry.text;
+        }
+        return entry.nullable ? "YES" : "NO";
+    } else if(command == "FOLLOW"){
+        if(args.size() != 1 || !followSets.count(args[0])){
+            return "ERROR: FOLLOW expects one non-terminal";
+        }
+        return SetToString(g, followSets[args[0]], "$");
+    } else if(command == "USEFUL"){
+        if(args.size() < 2 || args[1] != "->"){
+            return "ERROR: USEFUL expects a rule";
+        }
+        std::string text = RuleToString(args[0], std::vector<std::string>(args.begin() + 2, args.end()));
+        if(!allRules.count(text)){
+            return "ERROR: unknown rule " + text;
+        }
+        return usefulRules.count(text) ? "YES" : "NO";
+    }
+    return "ERROR: unknown query " + command;
+}
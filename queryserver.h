@@ -0,0 +1,53 @@
+#ifndef __QUERYSERVER__H__
+#define __QUERYSERVER__H__
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "grammar.h"
+
+// Query server: loads the grammar once and answers one query per line.
+//
+//   FIRST <symbols>        FIRST of a sentential form, printed like task 3
+//   NULLABLE <symbols>     YES if the sentential form derives epsilon
+//   FOLLOW <nonterminal>   printed like task 4
+//   USEFUL <rule>          YES if the rule is kept by task 2, e.g. USEFUL A -> b C
+//
+// "#" stands for the empty sentential form. Answers for FIRST and NULLABLE
+// are memoized per sentential form in a least recently used cache.
+
+struct firstEntry {
+    std::string text;   // FIRST set formatted with SetToString
+    bool nullable;
+};
+
+class FirstCache{
+    public:
+        explicit FirstCache(int capacity);
+        bool lookup(const std::string& key, firstEntry& entry);
+        void insert(const std::string& key, const firstEntry& entry);
+    private:
+        typedef std::list<std::pair<std::string, firstEntry>> entryList;
+        int capacity;
+        entryList entries; // most recently used first
+        std::unordered_map<std::string, entryList::iterator> index;
+};
+
+class QueryServer{
+    public:
+        explicit QueryServer(const Grammar& grammar);
+        std::string answer(const std::string& line);
+    private:
+        const Grammar& g;
+        symbolSets firstSets;
+        symbolSets followSets;
+        std::unordered_set<std::string> allRules;       // rules in task 2 format
+        std::unordered_set<std::string> usefulRules;
+        FirstCache cache;
+        bool firstOfSequence(const std::vector<std::string>& symbols, firstEntry& entry, std::string& error);
+};
+
+#endif  //__QUERYSERVER__H__
@@ -0,0 +1,74 @@
+#ifndef __SPSC_QUEUE__H__
+#define __SPSC_QUEUE__H__
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. push() waits while the queue is full and pop() waits while it is
+// empty, yielding the processor so that the other stage can run.
+template <typename T>
+class SpscQueue {
+  public:
+    explicit SpscQueue(size_t capacity);
+
+    void push(T item);
+    T pop();
+
+  private:
+    SpscQueue(const SpscQueue&);
+    SpscQueue& operator=(const SpscQueue&);
+
+    std::vector<T> slots;
+    size_t mask;
+
+    // head and tail count pushes and pops; each is written by one thread
+    // only and kept on its own cache line
+    alignas(64) std::atomic<size_t> head;   // next slot to pop
+    size_t cachedTail;                      // consumer's last view of tail
+    alignas(64) std::atomic<size_t> tail;   // next slot to push
+    size_t cachedHead;                      // producer's last view of head
+};
+
+// capacity is rounded up to a power of two
+template <typename T>
+SpscQueue<T>::SpscQueue(size_t capacity) : head(0), cachedTail(0), tail(0), cachedHead(0)
+{
+    size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+    slots.resize(size);
+    mask = size - 1;
+}
+
+template <typename T>
+void SpscQueue<T>::push(T item)
+{
+    size_t position = tail.load(std::memory_order_relaxed);
+    while (position - cachedHead == slots.size()) {
+        cachedHead = head.load(std::memory_order_acquire);
+        if (position - cachedHead == slots.size())
+            std::this_thread::yield();
+    }
+    slots[position & mask] = std::move(item);
+    tail.store(position + 1, std::memory_order_release);
+}
+
+template <typename T>
+T SpscQueue<T>::pop()
+{
+    size_t position = head.load(std::memory_order_relaxed);
+    while (position == cachedTail) {
+        cachedTail = tail.load(std::memory_order_acquire);
+        if (position == cachedTail)
+            std::this_thread::yield();
+    }
+    T item = std::move(slots[position & mask]);
+    head.store(position + 1, std::memory_order_release);
+    return item;
+}
+
+#endif  //__SPSC_QUEUE__H__
@@ -0,0 +1,80 @@
+#include <string>
+#include <vector>
+
+#include "tasks.h"
+
+// formats sets of the non-terminals the way tasks 3 and 4 print them, e.g.
+// FIRST(S) = { a, # }
+std::string NonTerminalSetsOutput(const Grammar& g, symbolSets& sets, const std::string& name, const std::string& special)
+{
+    std::string output;
+    for(int i = 0; i < g.allSymbols.size(); i++){
+        if(g.nonTerminals.count(g.allSymbols[i])) {
+            output += name + "(" + g.allSymbols[i] + ") = ";
+            output += SetToString(g, sets[g.allSymbols[i]], special) + '\n';
+        }
+    }
+    return output;
+}
+
+// Task 1
+std::string TerminalsAndNoneTerminals(const Grammar& g)
+{
+    symbolLists lists = SymbolListsAlgo(g);
+    std::string output;
+    for(int i = 0; i < lists.terminals.size(); i++){
+        output += lists.terminals[i] + " ";
+    }
+    for(int j = 0; j < lists.nonTerminals.size(); j++){
+        output += lists.nonTerminals[j] + " ";
+    }
+    return output;
+}
+
+// Task 2
+std::string RemoveUselessSymbols(const Grammar& g)
+{
+    std::vector<rule> usefulRules = UsefulRulesAlgo(g);
+    std::string output;
+    for(int i = 0; i < usefulRules.size(); i++){
+        output += RuleToString(usefulRules[i].left, usefulRules[i].right) + "\n";
+    }
+    return output;
+}
+
+// Task 3
+std::string CalculateFirstSets(const Grammar& g)
+{
+    symbolSets firstSets = FirstSetAlgo(g);
+    return NonTerminalSetsOutput(g, firstSets, "FIRST", "#");
+}
+
+// Task 4
+std::string CalculateFollowSets(const Grammar& g)
+{
+    symbolSets followSets = FollowSetAlgo(g, FirstSetAlgo(g));
+    return NonTerminalSetsOutput(g, followSets, "FOLLOW", "$");
+}
+
+// the output of tasks 1 to 4
+std::string TaskOutput(const Grammar& g, int task)
+{
+    switch (task) {
+        case 1: return TerminalsAndNoneTerminals(g);
+        case 2: return RemoveUselessSymbols(g);
+        case 3: return CalculateFirstSets(g);
+        case 4: return CalculateFollowSets(g);
+    }
+    return "";
+}
+
+// FIRST or FOLLOW sets computed on the suffix table, printed like tasks 3
+// and 4
+std::string NormalizedSetsOutput(const Grammar& g, const suffixTable& table, int task)
+{
+    suffixSets sets = SuffixSetAlgo(table);
+    if(task == 3){
+        return NonTerminalSetsOutput(g, sets.first, "FIRST", "#");
+    }
+    return NonTerminalSetsOutput(g, sets.follow, "FOLLOW", "$");
+}
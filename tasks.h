@@ -0,0 +1,22 @@
+#ifndef __TASKS__H__
+#define __TASKS__H__
+
+#include <string>
+
+#include "grammar.h"
+#include "normalize.h"
+
+// Output of tasks 1 to 4, exactly as the command line prints it.
+
+std::string NonTerminalSetsOutput(const Grammar& g, symbolSets& sets, const std::string& name, const std::string& special);
+
+std::string TerminalsAndNoneTerminals(const Grammar& g);
+std::string RemoveUselessSymbols(const Grammar& g);
+std::string CalculateFirstSets(const Grammar& g);
+std::string CalculateFollowSets(const Grammar& g);
+std::string TaskOutput(const Grammar& g, int task);
+
+// tasks 3 and 4 for a grammar normalized with NormalizeGrammar()
+std::string NormalizedSetsOutput(const Grammar& g, const suffixTable& table, int task);
+
+#endif  //__TASKS__H__